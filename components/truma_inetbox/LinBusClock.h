@@ -0,0 +1,36 @@
+#pragma once
+
+#include <cstdint>
+#include "esphome/core/hal.h"
+
+#ifdef USE_ESP32
+#include <esp_timer.h>
+#endif  // USE_ESP32
+#ifdef USE_RP2040
+#include <pico/time.h>
+#endif  // USE_RP2040
+
+namespace esphome {
+namespace truma_inetbox {
+
+// Two views of the same monotonic microsecond clock:
+// - `lin_micros()` wraps every ~71 minutes. The LIN receive path uses it for intervals up to seconds, only through
+//   differences and `lin_time_reached`.
+// - `lin_micros64()` does not wrap. Use it for timestamps kept longer than that (CP Plus requests, init, updates).
+#ifdef USE_HOST
+// The host build runs against a virtual clock so a replayed bus capture behaves the same on every run.
+uint64_t lin_micros64();
+// Move the virtual clock forward and fire due `LinBusTimer`s. Only the simulation driving the host build calls this.
+void lin_micros_advance(uint32_t us);
+#elif defined(USE_ESP32)
+inline uint64_t lin_micros64() { return esp_timer_get_time(); }
+#elif defined(USE_RP2040)
+inline uint64_t lin_micros64() { return time_us_64(); }
+#endif
+inline uint32_t lin_micros() { return (uint32_t) lin_micros64(); }
+
+// `now` is at or past `deadline`. Correct across the 32 bit wraparound for deadlines less than 2^31 us apart.
+inline bool lin_time_reached(uint32_t now, uint32_t deadline) { return (int32_t) (now - deadline) >= 0; }
+
+}  // namespace truma_inetbox
+}  // namespace esphome
@@ -2,6 +2,9 @@
 #include "esphome/core/helpers.h"
 #include "esphome/core/log.h"
 #include "helpers.h"
+#ifdef USE_ESP32_FRAMEWORK_ESP_IDF
+#include <hal/uart_ll.h>
+#endif  // USE_ESP32_FRAMEWORK_ESP_IDF
 
 namespace esphome {
 namespace truma_inetbox {
@@ -28,23 +31,106 @@ static const char *const TAG = "truma_inetbox.LinBusListener";
 #define DIAGNOSTIC_FRAME_SLAVE 0x3d
 #define QUEUE_WAIT_DONT_BLOCK (TickType_t) 0
 
+static void dump_queue_stats(const char *name, uint32_t length, const LinBusQueueStats *stats) {
+  ESP_LOGCONFIG(TAG, "  %s: length %u, enqueued %u, dropped %u, high water %u, max latency %uus", name, length,
+                stats->get_enqueued(), stats->get_dropped(), stats->get_high_water(), stats->get_latency_max());
+}
+
+static const char *lin_checksum_model_to_str(u_int8_t model) {
+  switch (model) {
+    case LIN_CHECKSUM_MODEL_CLASSIC:
+      return "classic";
+    case LIN_CHECKSUM_MODEL_ENHANCED_MASTER:
+      return "enhanced (master)";
+    case LIN_CHECKSUM_MODEL_ENHANCED_SLAVE:
+      return "enhanced (slave)";
+    default:
+      return "unknown";
+  }
+}
+
+static void dump_histogram(const char *name, const LinBusHistogram *histogram) {
+  ESP_LOGCONFIG(TAG, "  %s: p50 %uus, p95 %uus, p99 %uus (%u samples)", name, histogram->get_percentile(50),
+                histogram->get_percentile(95), histogram->get_percentile(99), histogram->get_count());
+}
+
 void LinBusListener::dump_config() {
   ESP_LOGCONFIG(TAG, "LinBusListener:");
+  ESP_LOGCONFIG(TAG, "  LIN bus: %u", this->bus_index_);
   LOG_PIN("  CS Pin: ", this->cs_pin_);
   LOG_PIN("  FAULT Pin: ", this->fault_pin_);
   LOG_UPDATE_INTERVAL(this);
   ESP_LOGCONFIG(TAG, "  LIN checksum Version: %d", this->lin_checksum_ == LIN_CHECKSUM::LIN_CHECKSUM_VERSION_1 ? 1 : 2);
   ESP_LOGCONFIG(TAG, "  Observer mode: %s", YESNO(this->observer_mode_));
+  ESP_LOGCONFIG(TAG, "  RX cost: %.1f cycles/byte (%u bytes)", this->get_rx_cycles_per_byte(), this->rx_bytes_);
+  ESP_LOGCONFIG(TAG, "  Answers sent: %u, not ready: %u", this->lin_answers_sent_, this->lin_answers_not_ready_);
+  ESP_LOGCONFIG(TAG, "  Answer collisions: %u, bit errors: %u, suppressed: %u", this->lin_answer_collisions_,
+                this->lin_answer_bit_errors_, this->lin_answers_suppressed_);
+  for (u_int8_t pid = 0; pid < 64; pid++) {
+    const auto &answer = this->lin_answers_[pid];
+    auto sent = this->lin_pid_stats_[pid].answered;
+    if (sent > 0) {
+      ESP_LOGCONFIG(TAG, "  PID %02X answers sent: %u, collisions: %u, bit errors: %u, no echo: %u", pid, sent,
+                    answer.collisions, answer.bit_errors, answer.echo_missing);
+    }
+  }
+  ESP_LOGCONFIG(TAG, "  Frame timeouts: %u", this->frame_timeouts_);
+#if defined(USE_RP2040) || defined(USE_HOST)
+  ESP_LOGCONFIG(TAG, "  PIO engine: %s", YESNO(this->pio_engine_));
+  if (this->pio_engine_) {
+    dump_queue_stats("PIO RX ring", LIN_PIO_RX_RING_WORDS, &this->pio_rx_ring_stats_);
+  }
+#endif  // USE_RP2040 || USE_HOST
+#ifdef USE_ESP32_FRAMEWORK_ESP_IDF
+  ESP_LOGCONFIG(TAG, "  UART interrupt handler: %s", YESNO(this->uart_isr_));
+#endif  // USE_ESP32_FRAMEWORK_ESP_IDF
+  if (this->hardware_break_) {
+    ESP_LOGCONFIG(TAG, "  Hardware breaks: %u, resyncs: %u", this->hardware_breaks_, this->hardware_break_resyncs_);
+  }
+  for (u_int8_t pid = 0; pid < sizeof(this->lin_data_length_); pid++) {
+    if (this->lin_data_length_[pid] > 0 || this->lin_checksum_model_[pid] != 0) {
+      ESP_LOGCONFIG(TAG, "  PID %02X data length: %u, checksum: %s", pid, this->lin_data_length_[pid],
+                    lin_checksum_model_to_str(this->lin_checksum_model_[pid]));
+    }
+  }
+  ESP_LOGCONFIG(TAG, "  Checksum model deviations: %u", this->lin_checksum_deviations_);
+  ESP_LOGCONFIG(TAG, "  Baud rate tracking: %s", YESNO(this->baud_rate_tracking_));
+  ESP_LOGCONFIG(TAG, "  Measured baud rate: %.0f (%u frames), applied %u", this->get_measured_baud_rate(),
+                this->bit_time_samples_, this->applied_baud_rate_);
+  dump_histogram("Break to SYNC", &this->break_to_sync_);
+  dump_histogram("Header to response", &this->header_to_response_);
+  dump_histogram("Inter-byte gap", &this->inter_byte_gap_);
+  if (this->response_delay_ > 0) {
+    ESP_LOGCONFIG(TAG, "  Response delay: %uus, preempted: %u", this->response_delay_, this->lin_answers_preempted_);
+    dump_histogram("Response jitter", &this->response_jitter_);
+  }
+  ESP_LOGCONFIG(TAG, "  LIN trace: length %u, frames %u", TRUMA_TRACE_LENGTH, this->lin_trace_.get_written());
+  dump_queue_stats("LIN message queue", TRUMA_MSG_QUEUE_LENGTH, &this->lin_msg_queue_);
+  if (this->lin_frame_subscribed_.load()) {
+    dump_queue_stats("LIN frame queue", TRUMA_FRAME_QUEUE_LENGTH, &this->lin_frame_queue_);
+  }
+#if ESPHOME_LOG_LEVEL > ESPHOME_LOG_LEVEL_NONE
+  dump_queue_stats("Log queue", TRUMA_LOG_QUEUE_LENGTH, &this->log_queue_);
+  ESP_LOGCONFIG(TAG, "  Log messages coalesced: %u", this->log_coalesced_);
+  ESP_LOGCONFIG(TAG, "  Log filter: types %08X, PIDs %08X%08X", this->log_type_mask_.load(),
+                this->log_pid_mask_[1].load(), this->log_pid_mask_[0].load());
+#endif  // ESPHOME_LOG_LEVEL > ESPHOME_LOG_LEVEL_NONE
   this->check_uart_settings(9600, 2, esphome::uart::UART_CONFIG_PARITY_NONE, 8);
 }
 
 void LinBusListener::setup() {
   ESP_LOGCONFIG(TAG, "Setting up LIN BUS...");
-  this->time_per_baud_ = (1000.0f * 1000.0f / this->parent_->get_baud_rate());
-  this->time_per_lin_break_ = this->time_per_baud_ * this->lin_break_length * 1.1f;
-  this->time_per_pid_ = this->time_per_baud_ * this->frame_length_ * 1.1f;
-  this->time_per_first_byte_ = this->time_per_baud_ * this->frame_length_ * 5.0f;
-  this->time_per_byte_ = this->time_per_baud_ * this->frame_length_ * 1.1f;
+  this->set_timing_(this->parent_->get_baud_rate());
+
+  // Diagnostic frames always carry 8 data bytes and a classic checksum.
+  if (this->lin_data_length_[DIAGNOSTIC_FRAME_MASTER] == 0) {
+    this->set_lin_data_length(DIAGNOSTIC_FRAME_MASTER, 8);
+  }
+  if (this->lin_data_length_[DIAGNOSTIC_FRAME_SLAVE] == 0) {
+    this->set_lin_data_length(DIAGNOSTIC_FRAME_SLAVE, 8);
+  }
+  this->lin_checksum_model_[DIAGNOSTIC_FRAME_MASTER] = LIN_CHECKSUM_MODEL_CLASSIC;
+  this->lin_checksum_model_[DIAGNOSTIC_FRAME_SLAVE] = LIN_CHECKSUM_MODEL_CLASSIC;
 
   if (this->cs_pin_ != nullptr) {
     this->cs_pin_->setup();
@@ -54,12 +140,27 @@ void LinBusListener::setup() {
     this->fault_pin_->setup();
   }
 
+#ifdef USE_ESP32
+  this->frame_mutex_ = xSemaphoreCreateMutex();
+#endif  // USE_ESP32
+  this->frame_timer_.setup(LinBusListener::frame_timer_callback_, this);
+  if (this->response_delay_ > 0) {
+    this->answer_timer_.setup(LinBusListener::answer_timer_callback_, this, "lin_answer");
+  }
+
+  // Arm the first answers before any header can arrive.
+  this->lin_prepare_answers_();
+
   // call device specific function
   this->setup_framework();
 
-#if ESPHOME_LOG_LEVEL > ESPHOME_LOG_LEVEL_NONE
-  assert(this->log_queue_ != 0);
+  // Publish to interrupts and `loop1()` once the framework is set up.
+  if (!this->is_failed() && !this->register_instance_()) {
+    ESP_LOGE(TAG, "Only %u LIN buses are supported.", TRUMA_MAX_LIN_BUSES);
+    this->mark_failed();
+  }
 
+#if ESPHOME_LOG_LEVEL > ESPHOME_LOG_LEVEL_NONE
   // Register interval to submit log messages
   this->set_interval("logmsg", 50, [this]() { this->process_log_queue(QUEUE_WAIT_DONT_BLOCK); });
 #endif  // ESPHOME_LOG_LEVEL > ESPHOME_LOG_LEVEL_NONE
@@ -70,55 +171,339 @@ void LinBusListener::setup() {
   }
 }
 
-void LinBusListener::update() { this->check_for_lin_fault_(); }
+void LinBusListener::update() {
+  this->check_for_lin_fault_();
+  if (this->baud_rate_tracking_) {
+    this->apply_measured_baud_rate_();
+  }
+}
+
+void LinBusListener::set_timing_(uint32_t baud_rate) {
+  this->applied_baud_rate_ = baud_rate;
+  this->time_per_baud_ = (1000.0f * 1000.0f / baud_rate);
+  this->time_per_lin_break_ = this->time_per_baud_ * this->lin_break_length * 1.1f;
+  this->time_per_pid_ = this->time_per_baud_ * this->frame_length_ * 1.1f;
+  this->time_per_first_byte_ = this->time_per_baud_ * this->frame_length_ * 5.0f;
+  this->time_per_byte_ = this->time_per_baud_ * this->frame_length_ * 1.1f;
+  this->time_per_slot_ = this->time_per_baud_ * 10 * 9 * 1.4f;
+}
 
-void LinBusListener::write_lin_answer_(const u_int8_t *data, u_int8_t len) {
-  QUEUE_LOG_MSG log_msg = QUEUE_LOG_MSG();
-  if (!this->can_write_lin_answer_) {
-    log_msg.type = QUEUE_LOG_MSG_TYPE::ERROR_LIN_ANSWER_CAN_WRITE_LIN_ANSWER;
-    TRUMA_LOGE(log_msg);
+void LinBusListener::track_bit_time_(uint32_t sync_to_pid) {
+  // SYNC and PID are sent back to back: start bit, 8 data bits and stop bit of the PID.
+  uint32_t bit_time_q8 = ((uint64_t) sync_to_pid << 8) / 10;
+  uint32_t nominal_q8 = (1000 * 1000 * 256) / this->parent_->get_baud_rate();
+  // Ignore interrupt latency outliers and inter-byte space. LIN slaves must follow up to 14% drift.
+  if (bit_time_q8 < nominal_q8 * 85 / 100 || bit_time_q8 > nominal_q8 * 115 / 100) {
     return;
   }
-  this->can_write_lin_answer_ = false;
-  if (len > 8) {
-    log_msg.type = QUEUE_LOG_MSG_TYPE::ERROR_LIN_ANSWER_TOO_LONG;
-    TRUMA_LOGE(log_msg);
+  if (this->measured_bit_time_q8_ == 0) {
+    this->measured_bit_time_q8_ = bit_time_q8;
+  } else {
+    // Moving average over about 16 frames.
+    this->measured_bit_time_q8_ =
+        this->measured_bit_time_q8_ - (this->measured_bit_time_q8_ >> 4) + (bit_time_q8 >> 4);
+  }
+  this->bit_time_samples_++;
+}
+
+void LinBusListener::apply_measured_baud_rate_() {
+  // Average over enough frames before following the master.
+  if (this->bit_time_samples_ < 16) {
+    return;
+  }
+  auto baud_rate = (uint32_t) this->get_measured_baud_rate();
+  // 1% hysteresis, the UART itself tolerates a few percent.
+  if (baud_rate * 100 > this->applied_baud_rate_ * 99 && baud_rate * 100 < this->applied_baud_rate_ * 101) {
     return;
   }
+  ESP_LOGD(TAG, "Following master baud rate %u (was %u).", baud_rate, this->applied_baud_rate_);
+  this->set_framework_baud_rate_(baud_rate);
+  this->set_timing_(baud_rate);
+}
+
+LinBusListener *LinBusListener::instances_[TRUMA_MAX_LIN_BUSES] = {};
+std::atomic<size_t> LinBusListener::instance_count_{0};
+
+bool LinBusListener::register_instance_() {
+  auto index = instance_count_.load();
+  if (index >= TRUMA_MAX_LIN_BUSES) {
+    return false;
+  }
+  this->bus_index_ = index;
+  instances_[index] = this;
+  // Readers see the entry only after it is written.
+  instance_count_.store(index + 1);
+  return true;
+}
+
+bool LinBusListener::register_lin_provider(u_int8_t pid, lin_provider_t provider, void *arg, lin_consumer_t sent) {
+  auto handler = &this->lin_pid_handlers_[pid & 0x3F];
+  if (handler->provider != nullptr) {
+    ESP_LOGE(TAG, "PID %02X already has an answer provider.", pid);
+    return false;
+  }
+  handler->provider_arg = arg;
+  handler->provider = provider;
+  handler->sent = sent;
+  this->lin_provider_pids_[this->lin_provider_count_++] = pid & 0x3F;
+  return true;
+}
+
+bool LinBusListener::register_lin_consumer(u_int8_t pid, lin_consumer_t consumer, void *arg) {
+  auto handler = &this->lin_pid_handlers_[pid & 0x3F];
+  if (handler->consumer != nullptr) {
+    ESP_LOGE(TAG, "PID %02X already has a frame consumer.", pid);
+    return false;
+  }
+  handler->consumer_arg = arg;
+  handler->consumer = consumer;
+  return true;
+}
+
+void LinBusListener::lin_prepare_answers_() {
+  for (u_int8_t i = 0; i < this->lin_provider_count_; i++) {
+    auto pid = this->lin_provider_pids_[i];
+    if (this->is_lin_answer_armed_(pid)) {
+      continue;
+    }
+    const auto &handler = this->lin_pid_handlers_[pid];
+    u_int8_t data[8];
+    auto len = handler.provider(handler.provider_arg, pid, data);
+    if (len > 0) {
+      this->arm_lin_answer_(pid, data, len);
+    }
+  }
+}
+
+void LinBusListener::refresh_lin_answer(u_int8_t pid) {
+  pid &= 0x3F;
+  this->lin_answers_refresh_[pid >> 5].fetch_or(1u << (pid & 0x1F));
+  this->wake_lin_msg_task_();
+}
+
+void LinBusListener::refresh_lin_answers_() {
+  uint64_t pids =
+      ((uint64_t) this->lin_answers_refresh_[1].exchange(0) << 32) | this->lin_answers_refresh_[0].exchange(0);
+  for (u_int8_t i = 0; i < this->lin_provider_count_ && pids != 0; i++) {
+    auto pid = this->lin_provider_pids_[i];
+    if ((pids & ((uint64_t) 1 << pid)) == 0) {
+      continue;
+    }
+    const auto &handler = this->lin_pid_handlers_[pid];
+    u_int8_t data[8];
+    auto len = handler.provider(handler.provider_arg, pid, data);
+    const auto answer = &this->lin_answers_[pid];
+    if (answer->state.load() == LIN_ANSWER_ARMED && answer->len == len + 1 && memcmp(answer->data, data, len) == 0) {
+      continue;
+    }
+    // An answer being sent is not replaced. The provider is called again once it was sent.
+    if (!this->disarm_lin_answer_(pid) && this->is_lin_answer_armed_(pid)) {
+      continue;
+    }
+    if (len > 0) {
+      this->arm_lin_answer_(pid, data, len);
+    }
+  }
+}
+
+bool LinBusListener::disarm_lin_answer_(const u_int8_t pid) {
+  u_int8_t armed = LIN_ANSWER_ARMED;
+  return this->lin_answers_[pid & 0x3F].state.compare_exchange_strong(armed, LIN_ANSWER_FREE);
+}
+
+bool LinBusListener::arm_lin_answer_(const u_int8_t pid, const u_int8_t *data, u_int8_t len) {
+  auto answer = &this->lin_answers_[pid & 0x3F];
+  if (answer->state.load() != LIN_ANSWER_FREE) {
+    ESP_LOGE(TAG, "PID %02X      answer is already armed.", pid);
+    return false;
+  }
+  if (len > 8) {
+    ESP_LOGE(TAG, "LIN answer cannot be longer than 8 bytes.");
+    return false;
+  }
 
   u_int8_t data_CRC = 0;
-  if (this->lin_checksum_ == LIN_CHECKSUM::LIN_CHECKSUM_VERSION_1 || this->current_PID_ == DIAGNOSTIC_FRAME_SLAVE) {
+  if (this->lin_checksum_ == LIN_CHECKSUM::LIN_CHECKSUM_VERSION_1 || pid == DIAGNOSTIC_FRAME_SLAVE) {
     // LIN checksum V1
     data_CRC = data_checksum(data, len, 0);
   } else {
     // LIN checksum V2
-    data_CRC = data_checksum(data, len, this->current_PID_with_parity_);
+    data_CRC = data_checksum(data, len, pid | (addr_parity(pid) << 6));
+  }
+
+  memcpy(answer->data, data, len);
+  answer->data[len] = data_CRC;
+  answer->len = len + 1;
+  answer->used = true;
+  // Publish the answer to the receive path.
+  answer->state.store(LIN_ANSWER_ARMED);
+  return true;
+}
+
+void LinBusListener::write_lin_answer_() {
+  auto answer = &this->lin_answers_[this->current_PID_];
+  if (answer->state.load() != LIN_ANSWER_ARMED) {
+    if (answer->used) {
+      // I am answering this PID, but the message task has not prepared the next answer yet.
+      this->lin_answers_not_ready_++;
+    }
+    return;
+  }
+
+  if (this->answer_blocked_) {
+    if (!lin_time_reached(this->current_frame_.pid_at, this->answer_blocked_since_ + this->time_per_slot_)) {
+      // A header inside the slot of a collided answer is noise or the other sender's data. The answer stays armed for
+      // the next header.
+      this->lin_answers_suppressed_++;
+      return;
+    }
+    this->answer_blocked_ = false;
+  }
+
+  // Without `response_delay` I am answering ~50-60us after the stop bit. Normal communication has a ~100us pause
+  // (second stop bits), the heater is answering after ~500-600us.
+  if (this->response_delay_ > 0 && !this->observer_mode_) {
+    // The answer stays armed until the answer timer sends it.
+    this->answer_deadline_ = this->current_frame_.pid_at + this->response_delay_;
+    this->answer_scheduled_ = true;
+    this->answer_timer_.start_at(this->answer_deadline_);
+    return;
+  }
+  this->send_lin_answer_(answer);
+}
+
+void LinBusListener::answer_timer_callback_(void *args) {
+  LinBusListener *instance = (LinBusListener *) args;
+#ifdef USE_ESP32_FRAMEWORK_ESP_IDF
+  if (instance->uart_isr_) {
+    // esp_timer task. Shares the frame state with the UART interrupt.
+    instance->frame_spinlock_take_();
+    instance->handle_answer_timer_(lin_micros());
+    instance->frame_spinlock_give_();
+    return;
+  }
+#endif  // USE_ESP32_FRAMEWORK_ESP_IDF
+#ifdef USE_ESP32
+  // Never wait for the receive path in the esp_timer task. If it holds the mutex it sends the answer when it is done.
+  instance->answer_timer_pending_.store(true);
+  instance->handle_pending_timers_();
+#elif defined(USE_RP2040)
+  // Interrupt context. `onSerialEvent` sends the answer.
+  instance->answer_timer_pending_.store(true);
+  // Wake `loop1()`.
+  __sev();
+#else
+  if (instance->pio_engine_) {
+    // A response of another node might only be in the `lin_rx` FIFO model.
+    instance->pio_drain_();
+  }
+  instance->handle_answer_timer_(lin_micros());
+#endif
+}
+
+#ifdef USE_ESP32
+void LinBusListener::frame_mutex_give_() {
+  xSemaphoreGive(this->frame_mutex_);
+  this->handle_pending_timers_();
+}
+
+void LinBusListener::handle_pending_timers_() {
+  // The flags are set before the mutex is tried and checked after it is given, so either the timer or the holder
+  // handles them.
+  while ((this->answer_timer_pending_.load() || this->frame_timeout_pending_.load()) &&
+         xSemaphoreTake(this->frame_mutex_, 0) == pdTRUE) {
+    if (this->answer_timer_pending_.exchange(false)) {
+      this->handle_answer_timer_(lin_micros());
+    }
+    if (this->frame_timeout_pending_.exchange(false)) {
+      this->handle_frame_timeout_(lin_micros());
+    }
+    xSemaphoreGive(this->frame_mutex_);
   }
+}
+#endif  // USE_ESP32
 
-  // I am answering too quick ~50-60us after stop bit. Normal communication has a ~100us pause (second stop bits).
-  // The heater is answering after ~500-600us.
-  // If there is any issue I might have to add a delay here.
-  // Check when last byte was read from buffer and wait at least one baud time.
-  // It is working when I answer quicker.
+#ifdef USE_ESP32_FRAMEWORK_ESP_IDF
+void LinBusListener::frame_spinlock_take_() { portENTER_CRITICAL_SAFE(&this->frame_spinlock_); }
+
+void LinBusListener::frame_spinlock_give_() {
+  bool wake = this->lin_msg_wake_pending_;
+  this->lin_msg_wake_pending_ = false;
+  portEXIT_CRITICAL_SAFE(&this->frame_spinlock_);
+  if (wake) {
+    this->wake_lin_msg_task_();
+  }
+}
+#endif  // USE_ESP32_FRAMEWORK_ESP_IDF
 
+void LinBusListener::handle_answer_timer_(uint32_t current) {
+  if (!this->answer_scheduled_) {
+    // The frame of the answer ended before the deadline.
+    return;
+  }
+  this->answer_scheduled_ = false;
+  if (this->current_state_ != READ_STATE_DATA || this->current_data_count_ > 0) {
+    // Another node started answering in the response space.
+    this->lin_answers_preempted_++;
+    return;
+  }
+  this->response_jitter_.add(lin_time_reached(current, this->answer_deadline_) ? current - this->answer_deadline_ : 0);
+  this->send_lin_answer_(&this->lin_answers_[this->current_PID_]);
+}
+
+void LinBusListener::send_lin_answer_(LIN_ANSWER *answer) {
+  u_int8_t armed = LIN_ANSWER_ARMED;
+  if (!answer->state.compare_exchange_strong(armed, LIN_ANSWER_SENDING)) {
+    // Disarmed by the message task since the header.
+    this->lin_answers_not_ready_++;
+    return;
+  }
   if (!this->observer_mode_) {
     this->current_PID_order_answered_ = true;
-    this->write_array(data, len);
-    this->write(data_CRC);
+    memcpy(this->tx_echo_, answer->data, answer->len);
+    this->tx_echo_len_ = answer->len;
+    // Data and checksum in one write.
+#ifdef USE_ESP32_FRAMEWORK_ESP_IDF
+    if (this->uart_isr_) {
+      // The UART driver is not installed. The answer fits into the empty TX FIFO.
+      uart_ll_write_txfifo(UART_LL_GET_HW(this->uart_num_), answer->data, answer->len);
+    } else {
+      this->write_array(answer->data, answer->len);
+    }
+#elif defined(USE_RP2040)
+    // Called from the UART or PIO interrupt, or `onSerialEvent` for a delayed answer. The TX interrupt or DMA sends the
+    // remaining bytes.
+    this->uart_tx_start_(answer->data, answer->len);
+#else
+    this->write_array(answer->data, answer->len);
+#endif  // USE_ESP32_FRAMEWORK_ESP_IDF
+    this->lin_answers_sent_++;
+    this->lin_pid_stats_[this->current_PID_].answered++;
   }
 
-  log_msg.type = QUEUE_LOG_MSG_TYPE::VERBOSE_LIN_ANSWER_RESPONSE;
-  log_msg.current_PID = this->current_PID_;
-  for (u_int8_t i = 0; i < len; i++) {
-    log_msg.data[i] = data[i];
+#ifdef ESPHOME_LOG_HAS_VERBOSE
+  if (TRUMA_LOG_ENABLED_ISR(QUEUE_LOG_MSG_TYPE::VERBOSE_LIN_ANSWER_RESPONSE, this->current_PID_)) {
+    QUEUE_LOG_MSG log_msg = QUEUE_LOG_MSG();
+    log_msg.type = QUEUE_LOG_MSG_TYPE::VERBOSE_LIN_ANSWER_RESPONSE;
+    log_msg.current_PID = this->current_PID_;
+    memcpy(log_msg.data, answer->data, answer->len);
+    log_msg.len = answer->len;
+    TRUMA_LOGV_ISR(log_msg);
   }
-  log_msg.data[len] = data_CRC;
-  log_msg.len = len++;
-  TRUMA_LOGV(log_msg);
+#endif  // ESPHOME_LOG_HAS_VERBOSE
+
+  // Hand the slot back to the message task and let it arm the next answer.
+  QUEUE_LIN_MSG lin_msg;
+  lin_msg.current_PID = this->current_PID_;
+  lin_msg.len = answer->len - 1;
+  memcpy(lin_msg.data, answer->data, lin_msg.len);
+  lin_msg.answer_sent = true;
+  answer->state.store(LIN_ANSWER_FREE);
+  this->lin_msg_queue_push_(lin_msg);
 }
 
 bool LinBusListener::check_for_lin_fault_() {
-  // Check if Lin Bus is faulty.
+  // Check if Lin Bus is faulty. Only called by the main task, the receive path checks `get_lin_bus_fault`.
   if (this->fault_pin_ != nullptr) {
     // Fault pin is inverted (HIGH = no fault)
     if (!this->fault_pin_->digital_read()) {
@@ -128,129 +513,347 @@ bool LinBusListener::check_for_lin_fault_() {
         this->fault_on_lin_bus_reported_ = 0x0F;
       }
       if (this->fault_on_lin_bus_reported_ % 3 == 0) {
-        QUEUE_LOG_MSG log_msg = QUEUE_LOG_MSG();
-        log_msg.type = QUEUE_LOG_MSG_TYPE::ERROR_CHECK_FOR_LIN_FAULT_DETECTED;
-        TRUMA_LOGE(log_msg);
+        ESP_LOGE(TAG, "Fault on LIN BUS detected.");
       }
     } else if (this->get_lin_bus_fault()) {
       this->fault_on_lin_bus_reported_ = 0;
-      QUEUE_LOG_MSG log_msg = QUEUE_LOG_MSG();
-      log_msg.type = QUEUE_LOG_MSG_TYPE::INFO_CHECK_FOR_LIN_FAULT_FIXED;
-      TRUMA_LOGI(log_msg);
+      ESP_LOGI(TAG, "Fault on LIN BUS fixed.");
     } else {
       this->fault_on_lin_bus_reported_ = 0;
     }
   }
+  return this->get_lin_bus_fault();
+}
 
+void LinBusListener::onReceive_() {
+#ifdef USE_ESP32
+  xSemaphoreTake(this->frame_mutex_, portMAX_DELAY);
+#endif  // USE_ESP32
   if (this->get_lin_bus_fault()) {
     this->current_state_reset_();
     // Ignore any data present in buffer
     this->clear_uart_buffer_();
-    return true;
   } else {
-    return false;
+    auto start_cycles = arch_get_cpu_cycle_count();
+    uint32_t bytes = 0;
+#ifdef TRUMA_LIN_RX_BYTEWISE
+    // Reference path for benchmarking: one `read_byte` and one clock read per byte.
+    u_int8_t buf;
+    while (this->available() && this->read_byte(&buf)) {
+      auto current = lin_micros();
+      this->read_lin_frame_(buf, current);
+      this->last_data_recieved_ = current;
+      this->last_rx_byte_ = buf;
+      bytes++;
+    }
+#else
+    // Drain the UART with one `read_array` per chunk.
+    u_int8_t buf[TRUMA_RX_CHUNK_LENGTH];
+    size_t len;
+    while ((len = this->available()) > 0) {
+      if (len > sizeof(buf)) {
+        len = sizeof(buf);
+      }
+      if (!this->read_array(buf, len)) {
+        break;
+      }
+      this->read_lin_chunk_(buf, len);
+      bytes += len;
+    }
+#endif  // TRUMA_LIN_RX_BYTEWISE
+    this->rx_cycles_ += arch_get_cpu_cycle_count() - start_cycles;
+    this->rx_bytes_ += bytes;
+    if (bytes > 0) {
+      this->start_frame_timer_();
+    }
   }
+#ifdef USE_ESP32
+  this->frame_mutex_give_();
+#endif  // USE_ESP32
 }
 
-void LinBusListener::onReceive_() {
-  if (!this->check_for_lin_fault_()) {
-    while (this->available()) {
-      this->read_lin_frame_();
-      this->last_data_recieved_ = micros();
+void LinBusListener::read_lin_chunk_(const u_int8_t *buf, size_t len) {
+  // The chunk is read when its last byte arrived. Earlier bytes are dated back one UART frame per byte.
+  auto current = lin_micros();
+  uint32_t time_per_uart_frame = this->time_per_baud_ * this->frame_length_;
+  for (size_t i = 0; i < len; i++) {
+    auto byte_at = current - (uint32_t) (len - 1 - i) * time_per_uart_frame;
+    this->rx_byte_exact_ = i == len - 1;
+    this->read_lin_frame_(buf[i], byte_at);
+    this->last_data_recieved_ = byte_at;
+  }
+  this->last_rx_byte_ = buf[len - 1];
+}
+
+void LinBusListener::read_lin_byte_(u_int8_t data, bool is_break) {
+  this->read_lin_chunk_(&data, 1);
+  if (is_break) {
+    this->handle_hardware_break_();
+  }
+}
+
+#if defined(USE_RP2040) || defined(USE_HOST)
+void LinBusListener::read_lin_pio_word_(uint32_t word, uint32_t current, uint32_t words_after) {
+  // The words were received back to back before the read at the latest. They were not in the buffer at the previous
+  // read, so the estimates stay in order.
+  auto byte_at = current - words_after * (uint32_t) (this->time_per_baud_ * this->frame_length_);
+  auto data = lin_pio_rx_data(word);
+  this->rx_byte_exact_ = false;
+  this->read_lin_frame_(data, byte_at);
+  this->last_data_recieved_ = byte_at;
+  this->last_rx_byte_ = data;
+  if (lin_pio_rx_is_break(word)) {
+    this->handle_hardware_break_();
+  }
+}
+#endif  // USE_RP2040 || USE_HOST
+
+void LinBusListener::start_frame_timer_() {
+  if (this->current_state_ != READ_STATE_BREAK) {
+    // Frame is incomplete. A timer left running for an earlier frame is ignored once the state is back at BREAK.
+    this->frame_timer_.start_at(this->last_data_recieved_ + this->time_per_first_byte_);
+  }
+}
+
+void LinBusListener::onHardwareBreak_() {
+#ifdef USE_ESP32
+  xSemaphoreTake(this->frame_mutex_, portMAX_DELAY);
+#endif  // USE_ESP32
+  this->handle_hardware_break_();
+#ifdef USE_ESP32
+  this->frame_mutex_give_();
+#endif  // USE_ESP32
+}
+
+void LinBusListener::handle_hardware_break_() {
+  this->hardware_breaks_++;
+  if (this->current_state_ != READ_STATE_SYNC) {
+    // The 0x00 of this break was not read as a frame start. End the current frame before it.
+    bool break_is_last_byte = this->last_rx_byte_ == LIN_BREAK;
+    if (break_is_last_byte && this->current_state_ == READ_STATE_DATA && this->current_data_count_ > 0) {
+      this->current_data_count_--;
+    }
+    this->close_lin_frame_();
+    this->current_state_reset_();
+    if (break_is_last_byte) {
+      // Resynchronised, the next byte is the SYNC.
+      this->current_state_ = READ_STATE_SYNC;
+      this->current_frame_.break_at = this->last_data_recieved_;
+      this->current_frame_.has_break = true;
+      this->hardware_break_resyncs_++;
+    } else {
+      // The 0x00 or SYNC that starts the next frame is still to be read.
+      this->hardware_break_pending_ = true;
+      return;
     }
   }
+  this->current_frame_break_detected_ = true;
 }
 
-void LinBusListener::read_lin_frame_() {
-  u_int8_t buf;
-  QUEUE_LOG_MSG log_msg = QUEUE_LOG_MSG();
+void LinBusListener::frame_timer_callback_(void *args) {
+  LinBusListener *instance = (LinBusListener *) args;
+#ifdef USE_ESP32_FRAMEWORK_ESP_IDF
+  if (instance->uart_isr_) {
+    instance->frame_spinlock_take_();
+    instance->handle_frame_timeout_(lin_micros());
+    instance->frame_spinlock_give_();
+    return;
+  }
+#endif  // USE_ESP32_FRAMEWORK_ESP_IDF
+#ifdef USE_ESP32
+  // Never wait for the receive path in the esp_timer task. If it holds the mutex it closes the frame when it is done.
+  instance->frame_timeout_pending_.store(true);
+  instance->handle_pending_timers_();
+#elif defined(USE_RP2040)
+  // Interrupt context. `onSerialEvent` closes the frame.
+  instance->frame_timeout_pending_.store(true);
+  // Wake `loop1()`.
+  __sev();
+#else
+  if (instance->pio_engine_) {
+    // Response bytes are only in the `lin_rx` FIFO model, it raises the IRQ at the PID.
+    instance->pio_drain_();
+  }
+  instance->handle_frame_timeout_(lin_micros());
+#endif
+}
 
-  switch (this->current_state_) {
-    case READ_STATE_BREAK:
-      // Check if there was an unanswered message before break.
-      if (this->current_PID_with_parity_ != 0x00 && this->current_PID_ != 0x00 && this->current_data_valid) {
-        if (this->current_data_count_ < 8) {
-          log_msg.current_PID = this->current_PID_;
-          if (this->current_PID_order_answered_) {
-            // Expectation is that I can see an echo of my data from the lin driver chip.
-            log_msg.type = QUEUE_LOG_MSG_TYPE::ERROR_READ_LIN_FRAME_UNABLE_TO_ANSWER;
-          } else {
-            log_msg.type = QUEUE_LOG_MSG_TYPE::ERROR_READ_LIN_FRAME_LOST_MSG;
-            for (u_int8_t i = 0; i < this->current_data_count_; i++) {
-              log_msg.data[i] = this->current_data_[i];
-            }
-            log_msg.len = this->current_data_count_;
+void LinBusListener::handle_frame_timeout_(uint32_t current) {
+  if (this->current_state_ == READ_STATE_BREAK ||
+      !lin_time_reached(current, this->last_data_recieved_ + this->time_per_first_byte_)) {
+    // Frame was completed or more data arrived after the timer was started.
+    return;
+  }
+  this->frame_timeouts_++;
+  if (this->current_state_ == READ_STATE_SYNC || this->current_state_ == READ_STATE_SID) {
+    u_int8_t expected = this->current_state_ == READ_STATE_SYNC ? LIN_BREAK : LIN_SYNC;
+    if (TRUMA_LOG_ENABLED_ISR(QUEUE_LOG_MSG_TYPE::VV_READ_LIN_FRAME_HEADER_TIMEOUT, expected)) {
+      QUEUE_LOG_MSG log_msg = QUEUE_LOG_MSG();
+      log_msg.type = QUEUE_LOG_MSG_TYPE::VV_READ_LIN_FRAME_HEADER_TIMEOUT;
+      log_msg.current_PID = expected;
+      TRUMA_LOGVV_ISR(log_msg);
+    }
+  } else {
+    this->close_lin_frame_();
+  }
+  this->current_state_reset_();
+}
+
+void LinBusListener::close_lin_frame_() {
+  // Check if there was an unanswered message.
+  if (this->current_PID_with_parity_ != 0x00 && this->current_PID_ != 0x00 && this->current_data_valid) {
+    if (this->current_data_count_ < this->expected_frame_length_() && this->learn_lin_data_length_()) {
+      // Frame of a PID with unknown length ended with a valid checksum.
+      this->finish_lin_frame_();
+    } else if (this->current_data_count_ < this->expected_frame_length_()) {
+      this->trace_lin_frame_(LIN_TRACE_INCOMPLETE);
+      auto type = QUEUE_LOG_MSG_TYPE::ERROR_READ_LIN_FRAME_LOST_MSG;
+      if (this->current_PID_order_answered_) {
+        // Expectation is that I can see an echo of my data from the lin driver chip.
+        this->lin_answers_[this->current_PID_].echo_missing++;
+        type = QUEUE_LOG_MSG_TYPE::ERROR_READ_LIN_FRAME_UNABLE_TO_ANSWER;
+      } else if (this->current_data_count_ == 0) {
+        this->lin_pid_stats_[this->current_PID_].lost_frames++;
+      } else {
+        this->lin_pid_stats_[this->current_PID_].partial_frames++;
+        this->count_lin_data_length_error_();
+      }
+      if (TRUMA_LOG_ENABLED_ISR(type, this->current_PID_)) {
+        QUEUE_LOG_MSG log_msg = QUEUE_LOG_MSG();
+        log_msg.type = type;
+        log_msg.current_PID = this->current_PID_;
+        if (type == QUEUE_LOG_MSG_TYPE::ERROR_READ_LIN_FRAME_LOST_MSG) {
+          for (u_int8_t i = 0; i < this->current_data_count_; i++) {
+            log_msg.data[i] = this->current_data_[i];
           }
-          TRUMA_LOGE_ISR(log_msg);
+          log_msg.len = this->current_data_count_;
         }
+        TRUMA_LOGE_ISR(log_msg);
       }
+    }
+  } else if (this->current_PID_ != 0x00 && this->current_state_ == READ_STATE_DATA) {
+    // Header with SID parity error that did not reach the frame length.
+    this->trace_lin_frame_(LIN_TRACE_INCOMPLETE);
+  }
+}
+
+void LinBusListener::read_lin_frame_(u_int8_t buf, uint32_t current) {
+  switch (this->current_state_) {
+    case READ_STATE_BREAK:
+      // Check if there was an unanswered message before break.
+      this->close_lin_frame_();
 
       // Reset current state
       this->current_state_reset_();
+      this->current_frame_break_detected_ = this->hardware_break_pending_ && (buf == LIN_BREAK || buf == LIN_SYNC);
+      this->hardware_break_pending_ = false;
 
       // First is Break expected. Arduino platform does not relay BREAK if send as special.
-      if (!this->read_byte(&buf) || (buf != LIN_BREAK && buf != LIN_SYNC)) {
-        log_msg.type = QUEUE_LOG_MSG_TYPE::VV_READ_LIN_FRAME_BREAK_EXPECTED;
-        log_msg.current_PID = buf;
-        TRUMA_LOGVV_ISR(log_msg);
+      if (buf != LIN_BREAK && buf != LIN_SYNC) {
+        if (TRUMA_LOG_ENABLED_ISR(QUEUE_LOG_MSG_TYPE::VV_READ_LIN_FRAME_BREAK_EXPECTED, buf)) {
+          QUEUE_LOG_MSG log_msg = QUEUE_LOG_MSG();
+          log_msg.type = QUEUE_LOG_MSG_TYPE::VV_READ_LIN_FRAME_BREAK_EXPECTED;
+          log_msg.current_PID = buf;
+          TRUMA_LOGVV_ISR(log_msg);
+        }
       } else {
         if (buf == LIN_BREAK) {
           // ESP_LOGVV(TAG, "%02X BREAK received.", buf);
           this->current_state_ = READ_STATE_SYNC;
+          this->current_frame_.break_at = current;
+          this->current_frame_.has_break = true;
         } else if (buf == LIN_SYNC) {
           // ESP_LOGVV(TAG, "%02X SYNC found.", buf);
           this->current_state_ = READ_STATE_SID;
+          this->current_frame_.sync_at = current;
+          this->current_frame_.sync_exact = this->rx_byte_exact_;
         }
       }
       break;
     case READ_STATE_SYNC:
       // Second is Sync expected
-      if (!this->read_byte(&buf) || buf != LIN_SYNC) {
-        log_msg.type = QUEUE_LOG_MSG_TYPE::VV_READ_LIN_FRAME_SYNC_EXPECTED;
-        log_msg.current_PID = buf;
-        TRUMA_LOGVV_ISR(log_msg);
+      if (buf != LIN_SYNC) {
+        if (TRUMA_LOG_ENABLED_ISR(QUEUE_LOG_MSG_TYPE::VV_READ_LIN_FRAME_SYNC_EXPECTED, buf)) {
+          QUEUE_LOG_MSG log_msg = QUEUE_LOG_MSG();
+          log_msg.type = QUEUE_LOG_MSG_TYPE::VV_READ_LIN_FRAME_SYNC_EXPECTED;
+          log_msg.current_PID = buf;
+          TRUMA_LOGVV_ISR(log_msg);
+        }
         this->current_state_ = buf == LIN_BREAK ? READ_STATE_SYNC : READ_STATE_BREAK;
+        if (buf == LIN_BREAK) {
+          this->current_frame_.break_at = current;
+        }
       } else {
         // ESP_LOGVV(TAG, "%02X SYNC found.", buf);
         this->current_state_ = READ_STATE_SID;
+        this->current_frame_.sync_at = current;
+        this->current_frame_.sync_exact = this->rx_byte_exact_;
+        if (this->current_frame_.has_break) {
+          this->break_to_sync_.add(current - this->current_frame_.break_at);
+        }
       }
       break;
     case READ_STATE_SID:
-      this->read_byte(&(this->current_PID_with_parity_));
+      this->current_PID_with_parity_ = buf;
       this->current_PID_ = this->current_PID_with_parity_ & 0x3F;
+      this->current_frame_.pid = this->current_PID_;
+      this->current_frame_.pid_at = current;
+      this->count_lin_header_(current);
+#if ESPHOME_LOG_LEVEL > ESPHOME_LOG_LEVEL_NONE
+      this->flush_log_coalesce_(current);
+#endif  // ESPHOME_LOG_LEVEL > ESPHOME_LOG_LEVEL_NONE
+      if (this->current_frame_.sync_exact && this->rx_byte_exact_) {
+        this->track_bit_time_(current - this->current_frame_.sync_at);
+      }
       if (this->lin_checksum_ == LIN_CHECKSUM::LIN_CHECKSUM_VERSION_2) {
         if (this->current_PID_with_parity_ != (this->current_PID_ | (addr_parity(this->current_PID_) << 6))) {
-          log_msg.type = QUEUE_LOG_MSG_TYPE::WARN_READ_LIN_FRAME_SID_CRC;
-          log_msg.current_PID = this->current_PID_with_parity_;
-          TRUMA_LOGW_ISR(log_msg);
+          if (TRUMA_LOG_ENABLED_ISR(QUEUE_LOG_MSG_TYPE::WARN_READ_LIN_FRAME_SID_CRC, this->current_PID_with_parity_)) {
+            QUEUE_LOG_MSG log_msg = QUEUE_LOG_MSG();
+            log_msg.type = QUEUE_LOG_MSG_TYPE::WARN_READ_LIN_FRAME_SID_CRC;
+            log_msg.current_PID = this->current_PID_with_parity_;
+            TRUMA_LOGW_ISR(log_msg);
+          }
           this->current_data_valid = false;
+          this->lin_pid_stats_[this->current_PID_].sid_parity_errors++;
         }
       }
 
-      if (this->current_data_valid) {
-        this->can_write_lin_answer_ = true;
-
-        // Should I response to this PID order? Ask the handling class.
-        this->answer_lin_order_(this->current_PID_);
-        this->can_write_lin_answer_ = false;
+      if (this->current_data_valid && (!this->hardware_break_ || this->current_frame_break_detected_)) {
+        // Send the answer if one is armed for this PID. With hardware break detection a header that did not start with
+        // a break (0x00 data byte followed by 0x55) is not answered.
+        this->write_lin_answer_();
       }
 
       // Even on error read data.
       this->current_state_ = READ_STATE_DATA;
       break;
     case READ_STATE_DATA: {
-      auto current = micros();
-      if (current > (this->last_data_recieved_ + this->time_per_first_byte_)) {
-        // timeout occured.
+      if (!this->rx_buffered_ && lin_time_reached(current, this->last_data_recieved_ + this->time_per_first_byte_)) {
+        // timeout occured. This byte belongs to the next frame.
         this->current_state_ = READ_STATE_BREAK;
+        this->read_lin_frame_(buf, current);
         return;
       }
-      this->read_byte(&buf);
+      if (this->current_data_count_ == 0) {
+        this->current_frame_.response_at = current;
+        this->header_to_response_.add(current - this->current_frame_.pid_at);
+      } else {
+        auto gap = current - this->current_frame_.last_byte_at;
+        this->inter_byte_gap_.add(gap);
+        if (gap > this->current_frame_.max_gap) {
+          this->current_frame_.max_gap = gap;
+        }
+      }
+      this->current_frame_.last_byte_at = current;
+      if (this->current_PID_order_answered_) {
+        this->check_lin_answer_echo_(buf);
+      }
       this->current_data_[this->current_data_count_] = buf;
       this->current_data_count_++;
+      this->current_frame_.len = this->current_data_count_;
 
-      if (this->current_data_count_ >= sizeof(this->current_data_)) {
-        // End of data reached. There cannot be more than 9 bytes in a LIN frame.
+      if (this->current_data_count_ >= this->expected_frame_length_()) {
+        // End of data reached. The checksum is the last byte of the frame.
         this->current_state_ = READ_STATE_ACT;
       }
       break;
@@ -259,64 +862,237 @@ void LinBusListener::read_lin_frame_() {
       break;
   }
 
-  if (this->current_state_ == READ_STATE_ACT && this->current_data_count_ > 1) {
+  if (this->current_state_ == READ_STATE_ACT) {
+    this->finish_lin_frame_();
+  }
+}
+
+void LinBusListener::count_lin_header_(uint32_t current) {
+  auto stats = &this->lin_pid_stats_[this->current_PID_];
+  if (stats->frames > 0) {
+    uint32_t interval = current - stats->last_seen;
+    if (stats->frames > 1) {
+      int32_t deviation = interval > stats->interval ? interval - stats->interval : stats->interval - interval;
+      stats->jitter += (deviation - (int32_t) stats->jitter) / 16;
+    }
+    stats->interval = interval;
+  }
+  stats->last_seen = current;
+  stats->frames++;
+}
+
+void LinBusListener::check_lin_answer_echo_(u_int8_t buf) {
+  if (this->current_data_count_ >= this->tx_echo_len_) {
+    return;
+  }
+  auto sent = this->tx_echo_[this->current_data_count_];
+  if (buf == sent) {
+    return;
+  }
+  auto answer = &this->lin_answers_[this->current_PID_];
+  auto bit_errors = __builtin_popcount(buf ^ sent);
+  answer->bit_errors += bit_errors;
+  this->lin_answer_bit_errors_ += bit_errors;
+  if (this->current_answer_collision_) {
+    return;
+  }
+  // Another node sent in our slot. Count the slot once and do not answer again until it ended.
+  this->current_answer_collision_ = true;
+  answer->collisions++;
+  this->lin_answer_collisions_++;
+  this->answer_blocked_ = true;
+  this->answer_blocked_since_ = this->current_frame_.pid_at;
+
+  if (TRUMA_LOG_ENABLED_ISR(QUEUE_LOG_MSG_TYPE::WARN_LIN_ANSWER_COLLISION, this->current_PID_)) {
+    QUEUE_LOG_MSG log_msg = QUEUE_LOG_MSG();
+    log_msg.type = QUEUE_LOG_MSG_TYPE::WARN_LIN_ANSWER_COLLISION;
+    log_msg.current_PID = this->current_PID_;
+    log_msg.data[0] = this->current_data_count_;
+    log_msg.data[1] = sent;
+    log_msg.data[2] = buf;
+    TRUMA_LOGW_ISR(log_msg);
+  }
+}
+
+u_int8_t LinBusListener::expected_frame_length_() const {
+  auto len = this->lin_data_length_[this->current_PID_];
+  // There cannot be more than 9 bytes in a LIN frame.
+  return (len > 0 ? len : 8) + 1;
+}
+
+bool LinBusListener::learn_lin_data_length_() {
+  if (this->lin_data_length_[this->current_PID_] != 0 || this->current_data_count_ < 2) {
+    return false;
+  }
+  u_int8_t data_length = this->current_data_count_ - 1;
+  auto models = this->lin_checksum_model_[this->current_PID_];
+  if (this->match_lin_checksum_(data_length, models != 0 ? models : LIN_CHECKSUM_MODEL_ALL) == 0) {
+    return false;
+  }
+  // A truncated frame can end with a matching checksum by chance. Require the same length twice.
+  if (this->lin_data_length_candidate_[this->current_PID_] == data_length) {
+    this->lin_data_length_[this->current_PID_] = data_length;
+  }
+  this->lin_data_length_candidate_[this->current_PID_] = data_length;
+  return true;
+}
+
+void LinBusListener::count_lin_data_length_error_() {
+  auto pid = this->current_PID_;
+  if (this->lin_data_length_[pid] == 0 || ((this->lin_data_length_configured_ >> pid) & 1)) {
+    return;
+  }
+  this->lin_data_length_errors_[pid]++;
+  if (this->lin_data_length_errors_[pid] >= TRUMA_DATA_LENGTH_UNLEARN_FRAMES) {
+    // Learned from broken frames or the PID changed its length. Read up to 8 data bytes again.
+    this->lin_data_length_[pid] = 0;
+    this->lin_data_length_candidate_[pid] = 0;
+    this->lin_data_length_errors_[pid] = 0;
+  }
+}
+
+u_int8_t LinBusListener::match_lin_checksum_(u_int8_t data_length, u_int8_t models) const {
+  u_int8_t data_CRC = this->current_data_[data_length];
+  u_int8_t matches = 0;
+  if ((models & LIN_CHECKSUM_MODEL_CLASSIC) && data_CRC == data_checksum(this->current_data_, data_length, 0)) {
+    matches |= LIN_CHECKSUM_MODEL_CLASSIC;
+  }
+  if ((models & LIN_CHECKSUM_MODEL_ENHANCED_MASTER) &&
+      data_CRC == data_checksum(this->current_data_, data_length, this->current_PID_)) {
+    matches |= LIN_CHECKSUM_MODEL_ENHANCED_MASTER;
+  }
+  if ((models & LIN_CHECKSUM_MODEL_ENHANCED_SLAVE) &&
+      data_CRC == data_checksum(this->current_data_, data_length, this->current_PID_with_parity_)) {
+    matches |= LIN_CHECKSUM_MODEL_ENHANCED_SLAVE;
+  }
+  return matches;
+}
+
+void LinBusListener::learn_lin_checksum_model_(u_int8_t models) {
+  auto pid = this->current_PID_;
+  if (models == 0 || (models & (models - 1)) != 0) {
+    // No match, or ambiguous because the parity bits of the PID are 0.
+    return;
+  }
+  if (this->lin_checksum_model_[pid] == models) {
+    this->lin_checksum_model_votes_[pid] = 0;
+    return;
+  }
+  if (this->lin_checksum_model_candidate_[pid] != models) {
+    this->lin_checksum_model_candidate_[pid] = models;
+    this->lin_checksum_model_votes_[pid] = 0;
+  }
+  this->lin_checksum_model_votes_[pid]++;
+  if (this->lin_checksum_model_votes_[pid] >= TRUMA_CHECKSUM_LEARN_FRAMES) {
+    this->lin_checksum_model_[pid] = models;
+    this->lin_checksum_model_votes_[pid] = 0;
+
+    if (TRUMA_LOG_ENABLED_ISR(QUEUE_LOG_MSG_TYPE::INFO_READ_LIN_FRAME_CHECKSUM_MODEL, pid)) {
+      QUEUE_LOG_MSG log_msg = QUEUE_LOG_MSG();
+      log_msg.type = QUEUE_LOG_MSG_TYPE::INFO_READ_LIN_FRAME_CHECKSUM_MODEL;
+      log_msg.current_PID = pid;
+      log_msg.data[0] = models;
+      TRUMA_LOGI_ISR(log_msg);
+    }
+  }
+}
+
+void LinBusListener::finish_lin_frame_() {
+  if (this->current_data_count_ > 1) {
     u_int8_t data_length = this->current_data_count_ - 1;
-    u_int8_t data_CRC = this->current_data_[this->current_data_count_ - 1];
     bool message_source_know = false;
     bool message_from_master = true;
 
-    if (this->lin_checksum_ == LIN_CHECKSUM::LIN_CHECKSUM_VERSION_1 ||
-        (this->current_PID_ == DIAGNOSTIC_FRAME_MASTER || this->current_PID_ == DIAGNOSTIC_FRAME_SLAVE)) {
-      if (data_CRC != data_checksum(this->current_data_, data_length, 0)) {
-        log_msg.type = QUEUE_LOG_MSG_TYPE::WARN_READ_LIN_FRAME_LINv1_CRC;
+    // Once the model of this PID is learned only its checksum is computed.
+    auto learned_model = this->lin_checksum_model_[this->current_PID_];
+    auto models =
+        this->match_lin_checksum_(data_length, learned_model != 0 ? learned_model : LIN_CHECKSUM_MODEL_ALL);
+    if (models == 0) {
+      bool classic = learned_model == LIN_CHECKSUM_MODEL_CLASSIC ||
+                     (learned_model == 0 && this->lin_checksum_ == LIN_CHECKSUM::LIN_CHECKSUM_VERSION_1);
+      auto type = classic ? QUEUE_LOG_MSG_TYPE::WARN_READ_LIN_FRAME_LINv1_CRC
+                          : QUEUE_LOG_MSG_TYPE::WARN_READ_LIN_FRAME_LINv2_CRC;
+      if (classic) {
+        this->lin_pid_stats_[this->current_PID_].crc_v1_errors++;
+      } else {
+        this->lin_pid_stats_[this->current_PID_].crc_v2_errors++;
+      }
+      if (TRUMA_LOG_ENABLED_ISR(type, this->current_PID_)) {
+        QUEUE_LOG_MSG log_msg = QUEUE_LOG_MSG();
+        log_msg.type = type;
+        log_msg.current_PID = this->current_PID_;
         TRUMA_LOGW_ISR(log_msg);
-        this->current_data_valid = false;
       }
-      if (this->current_PID_ == DIAGNOSTIC_FRAME_MASTER) {
-        message_source_know = true;
-        message_from_master = true;
-      } else if (this->current_PID_ == DIAGNOSTIC_FRAME_SLAVE) {
-        message_source_know = true;
-        message_from_master = false;
+      this->current_data_valid = false;
+      this->count_lin_data_length_error_();
+      if (learned_model != 0) {
+        // The frame stays invalid. A PID that keeps using another model is learned again.
+        this->lin_checksum_deviations_++;
+        this->learn_lin_checksum_model_(this->match_lin_checksum_(data_length, LIN_CHECKSUM_MODEL_ALL));
       }
     } else {
-      u_int8_t data_CRC_master = data_checksum(this->current_data_, data_length, this->current_PID_);
-      u_int8_t data_CRC_slave = data_checksum(this->current_data_, data_length, this->current_PID_with_parity_);
-      if (data_CRC != data_CRC_master && data_CRC != data_CRC_slave) {
-        log_msg.type = QUEUE_LOG_MSG_TYPE::WARN_READ_LIN_FRAME_LINv2_CRC;
-        TRUMA_LOGW_ISR(log_msg);
-        this->current_data_valid = false;
+      this->lin_data_length_errors_[this->current_PID_] = 0;
+      this->learn_lin_checksum_model_(models);
+      if (this->current_data_valid) {
+        this->lin_pid_stats_[this->current_PID_].valid_frames++;
       }
+    }
+
+    if (this->current_PID_ == DIAGNOSTIC_FRAME_MASTER) {
+      message_source_know = true;
+      message_from_master = true;
+    } else if (this->current_PID_ == DIAGNOSTIC_FRAME_SLAVE) {
+      message_source_know = true;
+      message_from_master = false;
+    } else if (models & LIN_CHECKSUM_MODEL_ENHANCED_SLAVE) {
+      message_source_know = true;
+      message_from_master = false;
+    } else if (models & LIN_CHECKSUM_MODEL_ENHANCED_MASTER) {
       message_source_know = true;
-      if (data_CRC == data_CRC_slave) {
-        message_from_master = false;
-      }
     }
 
 #ifdef ESPHOME_LOG_HAS_VERBOSE
-    log_msg.type = QUEUE_LOG_MSG_TYPE::VERBOSE_READ_LIN_FRAME_MSG;
-    log_msg.current_PID = this->current_PID_;
-    for (u_int8_t i = 0; i < this->current_data_count_; i++) {
-      log_msg.data[i] = this->current_data_[i];
+    if (TRUMA_LOG_ENABLED_ISR(QUEUE_LOG_MSG_TYPE::VERBOSE_READ_LIN_FRAME_MSG, this->current_PID_)) {
+      QUEUE_LOG_MSG log_msg = QUEUE_LOG_MSG();
+      log_msg.type = QUEUE_LOG_MSG_TYPE::VERBOSE_READ_LIN_FRAME_MSG;
+      log_msg.current_PID = this->current_PID_;
+      for (u_int8_t i = 0; i < this->current_data_count_; i++) {
+        log_msg.data[i] = this->current_data_[i];
+      }
+      log_msg.len = this->current_data_count_;
+      log_msg.current_data_valid = this->current_data_valid;
+      log_msg.message_source_know = message_source_know;
+      log_msg.message_from_master = message_from_master;
+      TRUMA_LOGV_ISR(log_msg);
     }
-    log_msg.len = this->current_data_count_;
-    log_msg.current_data_valid = this->current_data_valid;
-    log_msg.message_source_know = message_source_know;
-    log_msg.message_from_master = message_from_master;
-    TRUMA_LOGV_ISR(log_msg);
 #endif  // ESPHOME_LOG_HAS_VERBOSE
 
-    if (this->current_data_valid && message_from_master) {
+    u_int8_t trace_flags = models != 0 ? LIN_TRACE_CHECKSUM_VALID : 0;
+    if (message_source_know) {
+      trace_flags |= message_from_master ? (LIN_TRACE_SOURCE_KNOWN | LIN_TRACE_FROM_MASTER) : LIN_TRACE_SOURCE_KNOWN;
+    }
+    this->trace_lin_frame_(trace_flags);
+
+    if (this->lin_frame_subscribed_.load()) {
+      auto source = !message_source_know ? LIN_FRAME_SOURCE::LIN_FRAME_SOURCE_UNKNOWN
+                    : message_from_master ? LIN_FRAME_SOURCE::LIN_FRAME_SOURCE_MASTER
+                                          : LIN_FRAME_SOURCE::LIN_FRAME_SOURCE_SLAVE;
+      this->lin_frame_queue_push_(data_length, models != 0, source);
+    }
+
+    if (this->current_data_valid && message_from_master &&
+        this->lin_pid_handlers_[this->current_PID_].consumer != nullptr) {
       QUEUE_LIN_MSG lin_msg;
       lin_msg.current_PID = this->current_PID_;
+      lin_msg.answer_sent = false;
       lin_msg.len = this->current_data_count_ - 1;
       for (u_int8_t i = 0; i < lin_msg.len; i++) {
         lin_msg.data[i] = this->current_data_[i];
       }
-      xQueueSendFromISR(this->lin_msg_queue_, (void *) &lin_msg, QUEUE_WAIT_DONT_BLOCK);
+      this->lin_msg_queue_push_(lin_msg);
     }
-    this->current_state_ = READ_STATE_BREAK;
   }
+  this->current_state_ = READ_STATE_BREAK;
 }
 
 void LinBusListener::clear_uart_buffer_() {
@@ -325,48 +1101,263 @@ void LinBusListener::clear_uart_buffer_() {
   }
 }
 
+void LinBusListener::lin_msg_queue_push_(const QUEUE_LIN_MSG &lin_msg) {
+  if (this->lin_msg_queue_.push(lin_msg, lin_micros())) {
+#ifdef USE_ESP32_FRAMEWORK_ESP_IDF
+    if (this->uart_isr_) {
+      // The receive path runs inside `frame_spinlock_`, `frame_spinlock_give_` wakes the task.
+      this->lin_msg_wake_pending_ = true;
+      return;
+    }
+#endif  // USE_ESP32_FRAMEWORK_ESP_IDF
+    this->wake_lin_msg_task_();
+  }
+}
+
+void LinBusListener::wake_lin_msg_task_() {
+#ifdef USE_ESP32
+  if (this->eventTaskHandle_ != nullptr) {
+    if (xPortInIsrContext()) {
+      // The message task runs at the next tick at the latest.
+      vTaskNotifyGiveFromISR(this->eventTaskHandle_, nullptr);
+    } else {
+      xTaskNotifyGive(this->eventTaskHandle_);
+    }
+  }
+#elif defined(USE_RP2040)
+  // Wake `loop1()` on core 1.
+  __sev();
+#endif  // USE_ESP32
+}
+
+void LinBusListener::lin_frame_queue_push_(u_int8_t data_length, bool checksum_valid, LIN_FRAME_SOURCE source) {
+  QUEUE_LIN_FRAME lin_frame;
+  lin_frame.received_at = this->current_frame_.pid_at;
+  lin_frame.current_PID = this->current_PID_;
+  memcpy(lin_frame.data, this->current_data_, data_length);
+  lin_frame.len = data_length;
+  lin_frame.checksum = this->current_data_[data_length];
+  lin_frame.source = source;
+  // Includes a SID parity error.
+  lin_frame.checksum_valid = checksum_valid && this->current_data_valid;
+  lin_frame.own_answer = this->current_PID_order_answered_;
+  this->lin_frame_queue_.push(lin_frame, lin_micros());
+}
+
+void LinBusListener::trace_lin_frame_(u_int8_t flags) {
+  LinTraceRecord record;
+  record.timestamp = this->current_frame_.pid_at;
+  record.pid = this->current_PID_with_parity_;
+  if (this->current_PID_with_parity_ != (this->current_PID_ | (addr_parity(this->current_PID_) << 6))) {
+    flags |= LIN_TRACE_SID_PARITY_ERROR;
+  }
+  if (this->current_PID_order_answered_) {
+    flags |= LIN_TRACE_OWN_ANSWER;
+  }
+  if (this->current_answer_collision_) {
+    flags |= LIN_TRACE_COLLISION;
+  }
+  if (this->current_frame_break_detected_) {
+    flags |= LIN_TRACE_HARDWARE_BREAK;
+  }
+  record.flags = flags;
+  record.len = this->current_data_count_;
+  // Bytes after `current_data_count_` are zero since the frame started.
+  memcpy(record.data, this->current_data_, sizeof(record.data));
+  this->lin_trace_.add(record);
+}
+
+void LinBusListener::dump_lin_pid_stats() {
+  auto now = lin_micros();
+  ESP_LOGI(TAG, "LIN statistics bus %u:", this->bus_index_);
+  for (u_int8_t pid = 0; pid < 64; pid++) {
+    const auto &stats = this->lin_pid_stats_[pid];
+    if (stats.frames == 0) {
+      continue;
+    }
+    ESP_LOGI(TAG,
+             "PID %02X frames %u, valid %u, SID %u, CRC v1 %u, v2 %u, lost %u, partial %u, answered %u, seen %ums ago, "
+             "interval %uus, jitter %uus",
+             pid, stats.frames, stats.valid_frames, stats.sid_parity_errors, stats.crc_v1_errors, stats.crc_v2_errors,
+             stats.lost_frames, stats.partial_frames, stats.answered, (now - stats.last_seen) / 1000, stats.interval,
+             stats.jitter);
+  }
+}
+
+void LinBusListener::dump_lin_trace() {
+  auto end = this->lin_trace_.get_written();
+  uint32_t seq = end > TRUMA_TRACE_LENGTH - 1 ? end - (TRUMA_TRACE_LENGTH - 1) : 0;
+  ESP_LOGI(TAG, "LIN trace bus %u: frames %u..%u, now %u", this->bus_index_, seq, end, lin_micros());
+  // Four records per line, each as its 16 bytes in memory order.
+  LinTraceRecord records[4];
+  char hex[sizeof(records) * 2 + 1];
+  while ((int32_t) (end - seq) > 0) {
+    auto max = std::min<uint32_t>(end - seq, 4);
+    auto count = this->lin_trace_.read(&seq, records, max);
+    if (count == 0) {
+      continue;
+    }
+    const auto *bytes = reinterpret_cast<const u_int8_t *>(records);
+    for (size_t i = 0; i < count * sizeof(LinTraceRecord); i++) {
+      snprintf(&hex[i * 2], 3, "%02X", bytes[i]);
+    }
+    ESP_LOGI(TAG, "LIN trace %u: %s", (uint32_t) (seq - count), hex);
+  }
+}
+
+void LinBusListener::add_on_lin_frame_callback(std::function<void(const QUEUE_LIN_FRAME *)> &&callback) {
+  this->lin_frame_callback_.add(std::move(callback));
+  if (!this->lin_frame_subscribed_.exchange(true)) {
+    this->set_interval("linframe", 50, [this]() { this->process_lin_frame_queue(); });
+  }
+}
+
+void LinBusListener::process_lin_frame_queue() {
+  QUEUE_LIN_FRAME lin_frames[TRUMA_FRAME_QUEUE_LENGTH];
+  auto count = this->lin_frame_queue_.pop(lin_frames, TRUMA_FRAME_QUEUE_LENGTH, lin_micros());
+  for (size_t i = 0; i < count; i++) {
+    this->lin_frame_callback_.call(&lin_frames[i]);
+  }
+}
+
 void LinBusListener::process_lin_msg_queue(TickType_t xTicksToWait) {
-  QUEUE_LIN_MSG lin_msg;
-  while (xQueueReceive(this->lin_msg_queue_, &lin_msg, xTicksToWait) == pdPASS) {
-    this->lin_message_recieved_(lin_msg.current_PID, lin_msg.data, lin_msg.len);
+#ifdef USE_ESP32
+  if (this->lin_msg_queue_.empty()) {
+    ulTaskNotifyTake(pdTRUE, xTicksToWait);
+  }
+#endif  // USE_ESP32
+  QUEUE_LIN_MSG lin_msgs[TRUMA_MSG_QUEUE_LENGTH];
+  size_t count;
+  while ((count = this->lin_msg_queue_.pop(lin_msgs, TRUMA_MSG_QUEUE_LENGTH, lin_micros())) > 0) {
+    for (size_t i = 0; i < count; i++) {
+      const auto &handler = this->lin_pid_handlers_[lin_msgs[i].current_PID];
+      if (lin_msgs[i].answer_sent) {
+        // Otherwise only wakes the task to arm the next answer.
+        if (handler.sent != nullptr) {
+          handler.sent(handler.provider_arg, lin_msgs[i].current_PID, lin_msgs[i].data, lin_msgs[i].len);
+        }
+      } else if (lin_msgs[i].len > 0) {
+        handler.consumer(handler.consumer_arg, lin_msgs[i].current_PID, lin_msgs[i].data, lin_msgs[i].len);
+      }
+    }
+    this->lin_prepare_answers_();
+  }
+  this->refresh_lin_answers_();
+}
+
+#if ESPHOME_LOG_LEVEL > ESPHOME_LOG_LEVEL_NONE
+void LinBusListener::log_queue_push_coalesced_(const QUEUE_LOG_MSG &log_msg) {
+  auto current = lin_micros();
+  LOG_COALESCE_SLOT *target = nullptr;
+  for (auto &slot : this->log_coalesce_) {
+    if (slot.type == log_msg.type && slot.current_PID == log_msg.current_PID &&
+        (slot.len == 0) == (log_msg.len == 0)) {
+      if (!lin_time_reached(current, slot.since + TRUMA_LOG_COALESCE_US)) {
+        slot.repeats++;
+        slot.last_at = current;
+        slot.len = log_msg.len;
+        this->log_coalesced_++;
+        return;
+      }
+      target = &slot;
+      break;
+    }
+    // Take a free slot, otherwise the one with the oldest window.
+    if (target == nullptr || (target->type != QUEUE_LOG_MSG_TYPE::UNKNOWN &&
+                              (slot.type == QUEUE_LOG_MSG_TYPE::UNKNOWN ||
+                               current - slot.since > current - target->since))) {
+      target = &slot;
+    }
+  }
+  this->flush_log_coalesce_slot_(target);
+  target->type = log_msg.type;
+  target->current_PID = log_msg.current_PID;
+  target->len = log_msg.len;
+  target->since = current;
+  target->last_at = current;
+  this->log_queue_.push(log_msg, current);
+}
+
+void LinBusListener::flush_log_coalesce_slot_(LOG_COALESCE_SLOT *slot) {
+  if (slot->repeats > 0) {
+    QUEUE_LOG_MSG log_msg = QUEUE_LOG_MSG();
+    log_msg.type = slot->type;
+    log_msg.current_PID = slot->current_PID;
+    log_msg.len = slot->len;
+    log_msg.repeats = slot->repeats;
+    log_msg.repeat_window = slot->last_at - slot->since;
+    this->log_queue_.push(log_msg, lin_micros());
   }
+  *slot = LOG_COALESCE_SLOT();
 }
 
+void LinBusListener::flush_log_coalesce_(uint32_t current) {
+  for (auto &slot : this->log_coalesce_) {
+    if (slot.type != QUEUE_LOG_MSG_TYPE::UNKNOWN && lin_time_reached(current, slot.since + TRUMA_LOG_COALESCE_US)) {
+      this->flush_log_coalesce_slot_(&slot);
+    }
+  }
+}
+
+static const char *queue_log_msg_type_to_str(QUEUE_LOG_MSG_TYPE type) {
+  switch (type) {
+    case QUEUE_LOG_MSG_TYPE::ERROR_READ_LIN_FRAME_UNABLE_TO_ANSWER:
+      return "order - unable to send response";
+    case QUEUE_LOG_MSG_TYPE::WARN_LIN_ANSWER_COLLISION:
+      return "answer collision";
+    case QUEUE_LOG_MSG_TYPE::ERROR_READ_LIN_FRAME_LOST_MSG:
+      return "partial data received";
+    case QUEUE_LOG_MSG_TYPE::WARN_READ_LIN_FRAME_SID_CRC:
+      return "LIN CRC error on SID";
+    case QUEUE_LOG_MSG_TYPE::WARN_READ_LIN_FRAME_LINv1_CRC:
+      return "LIN v1 CRC error";
+    case QUEUE_LOG_MSG_TYPE::WARN_READ_LIN_FRAME_LINv2_CRC:
+      return "LIN v2 CRC error";
+    default:
+      return "message";
+  }
+}
+#endif  // ESPHOME_LOG_LEVEL > ESPHOME_LOG_LEVEL_NONE
+
 void LinBusListener::process_log_queue(TickType_t xTicksToWait) {
 #if ESPHOME_LOG_LEVEL > ESPHOME_LOG_LEVEL_NONE
-  QUEUE_LOG_MSG log_msg;
-  while (xQueueReceive(this->log_queue_, &log_msg, xTicksToWait) == pdPASS) {
+  QUEUE_LOG_MSG log_msgs[TRUMA_LOG_QUEUE_LENGTH];
+  auto count = this->log_queue_.pop(log_msgs, TRUMA_LOG_QUEUE_LENGTH, lin_micros());
+  for (size_t i = 0; i < count; i++) {
+    const auto &log_msg = log_msgs[i];
     auto current_PID = log_msg.current_PID;
+    if (log_msg.repeats > 0) {
+      if (log_msg.type == QUEUE_LOG_MSG_TYPE::ERROR_READ_LIN_FRAME_LOST_MSG && log_msg.len == 0) {
+        ESP_LOGV(TAG, "PID %02X      order no answer - repeated %u times in %ums", current_PID, log_msg.repeats,
+                 log_msg.repeat_window / 1000);
+      } else {
+        ESP_LOGW(TAG, "PID %02X      %s - repeated %u times in %ums", current_PID,
+                 queue_log_msg_type_to_str(log_msg.type), log_msg.repeats, log_msg.repeat_window / 1000);
+      }
+      continue;
+    }
     switch (log_msg.type) {
-      case QUEUE_LOG_MSG_TYPE::ERROR_LIN_ANSWER_CAN_WRITE_LIN_ANSWER:
-        ESP_LOGE(TAG, "Cannot answer LIN because there is no open order from master.");
-        break;
-      case QUEUE_LOG_MSG_TYPE::ERROR_LIN_ANSWER_TOO_LONG:
-        ESP_LOGE(TAG, "LIN answer cannot be longer than 8 bytes.");
-        break;
       case QUEUE_LOG_MSG_TYPE::VERBOSE_LIN_ANSWER_RESPONSE:
         if (!this->observer_mode_) {
-          ESP_LOGV(TAG, "RESPONSE %02X %s", current_PID, format_hex_pretty(log_msg.data, log_msg.len).c_str());
+          ESP_LOGV(TAG, "RESPONSE %02X %s", current_PID, format_hex_pretty_fixed(log_msg.data, log_msg.len).c_str());
         } else {
           ESP_LOGV(TAG, "RESPONSE %02X %s - NOT SEND (OBSERVER MODE)", current_PID,
-                   format_hex_pretty(log_msg.data, log_msg.len).c_str());
+                   format_hex_pretty_fixed(log_msg.data, log_msg.len).c_str());
         }
         break;
-      case QUEUE_LOG_MSG_TYPE::ERROR_CHECK_FOR_LIN_FAULT_DETECTED:
-        ESP_LOGE(TAG, "Fault on LIN BUS detected.");
-        break;
-      case QUEUE_LOG_MSG_TYPE::INFO_CHECK_FOR_LIN_FAULT_FIXED:
-        ESP_LOGI(TAG, "Fault on LIN BUS fixed.");
-        break;
       case QUEUE_LOG_MSG_TYPE::ERROR_READ_LIN_FRAME_UNABLE_TO_ANSWER:
         ESP_LOGE(TAG, "PID %02X      order - unable to send response", current_PID);
         break;
+      case QUEUE_LOG_MSG_TYPE::WARN_LIN_ANSWER_COLLISION:
+        ESP_LOGW(TAG, "PID %02X      answer collision at byte %u: sent %02X, read %02X", current_PID, log_msg.data[0],
+                 log_msg.data[1], log_msg.data[2]);
+        break;
       case QUEUE_LOG_MSG_TYPE::ERROR_READ_LIN_FRAME_LOST_MSG:
         if (log_msg.len == 0) {
           ESP_LOGV(TAG, "PID %02X      order no answer", current_PID);
         } else if (log_msg.len < 8) {
           ESP_LOGW(TAG, "PID %02X      %s partial data received", current_PID,
-                   format_hex_pretty(log_msg.data, log_msg.len).c_str());
+                   format_hex_pretty_fixed(log_msg.data, log_msg.len).c_str());
         }
         break;
       case QUEUE_LOG_MSG_TYPE::VV_READ_LIN_FRAME_BREAK_EXPECTED:
@@ -375,25 +1366,33 @@ void LinBusListener::process_log_queue(TickType_t xTicksToWait) {
       case QUEUE_LOG_MSG_TYPE::VV_READ_LIN_FRAME_SYNC_EXPECTED:
         ESP_LOGVV(TAG, "0x%02X Expected SYNC not found.", current_PID);
         break;
+      case QUEUE_LOG_MSG_TYPE::VV_READ_LIN_FRAME_HEADER_TIMEOUT:
+        ESP_LOGVV(TAG, "0x%02X Header timeout, next byte not received.", current_PID);
+        break;
       case QUEUE_LOG_MSG_TYPE::WARN_READ_LIN_FRAME_SID_CRC:
         ESP_LOGW(TAG, "0x%02X LIN CRC error on SID.", current_PID);
         break;
       case QUEUE_LOG_MSG_TYPE::WARN_READ_LIN_FRAME_LINv1_CRC:
-        ESP_LOGW(TAG, "LIN v1 CRC error");
+        ESP_LOGW(TAG, "PID %02X      LIN v1 CRC error", current_PID);
         break;
       case QUEUE_LOG_MSG_TYPE::WARN_READ_LIN_FRAME_LINv2_CRC:
-        ESP_LOGW(TAG, "LIN v2 CRC error");
+        ESP_LOGW(TAG, "PID %02X      LIN v2 CRC error", current_PID);
+        break;
+      case QUEUE_LOG_MSG_TYPE::INFO_READ_LIN_FRAME_CHECKSUM_MODEL:
+        ESP_LOGI(TAG, "PID %02X      checksum model: %s", current_PID, lin_checksum_model_to_str(log_msg.data[0]));
         break;
       case QUEUE_LOG_MSG_TYPE::VERBOSE_READ_LIN_FRAME_MSG:
         // Mark the PID of the TRUMA Combi heater as very verbose message.
         if (current_PID == 0x20 || current_PID == 0x21 || current_PID == 0x22 ||
             ((current_PID == DIAGNOSTIC_FRAME_MASTER || current_PID == DIAGNOSTIC_FRAME_SLAVE) &&
              log_msg.data[0] == 0x01 /* ID of heater */)) {
-          ESP_LOGVV(TAG, "PID %02X      %s %s %s", current_PID_, format_hex_pretty(log_msg.data, log_msg.len).c_str(),
+          ESP_LOGVV(TAG, "PID %02X      %s %s %s", current_PID_,
+                    format_hex_pretty_fixed(log_msg.data, log_msg.len).c_str(),
                     log_msg.message_source_know ? (log_msg.message_from_master ? " - MASTER" : " - SLAVE") : "",
                     log_msg.current_data_valid ? "" : "INVALID");
         } else {
-          ESP_LOGV(TAG, "PID %02X      %s %s %S", current_PID_, format_hex_pretty(log_msg.data, log_msg.len).c_str(),
+          ESP_LOGV(TAG, "PID %02X      %s %s %S", current_PID_,
+                   format_hex_pretty_fixed(log_msg.data, log_msg.len).c_str(),
                    log_msg.message_source_know ? (log_msg.message_from_master ? " - MASTER" : " - SLAVE") : "",
                    log_msg.current_data_valid ? "" : "INVALID");
         }
@@ -1,25 +1,62 @@
 #pragma once
 
+#include <atomic>
+#include "LinBusClock.h"
 #include "LinBusLog.h"
+#include "LinBusPio.h"
+#include "LinBusQueue.h"
+#include "LinBusTimer.h"
+#include "LinBusTiming.h"
+#include "LinBusTrace.h"
 #include "esphome/core/component.h"
+#include "esphome/core/helpers.h"
 #include "esphome/components/uart/uart.h"
 
 #ifdef USE_ESP32
 #include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
 #include <freertos/semphr.h>
 #endif  // USE_ESP32
+#ifdef USE_ESP32_FRAMEWORK_ESP_IDF
+#include <driver/uart.h>
+#endif  // USE_ESP32_FRAMEWORK_ESP_IDF
 #ifdef USE_RP2040
 #include <hardware/uart.h>
+#include <hardware/irq.h>
+#include <hardware/sync.h>
+#include <hardware/pio.h>
+#include <hardware/dma.h>
 #include <FreeRTOS.h>
-#include <semphr.h>
-#include <queue.h>
 #endif  // USE_RP2040
+#ifdef USE_HOST
+#include "freertos_host.h"
+#endif  // USE_HOST
 
+// Queue lengths must be a power of two.
 #ifndef  TRUMA_MSG_QUEUE_LENGTH
-#define TRUMA_MSG_QUEUE_LENGTH 6
+#define TRUMA_MSG_QUEUE_LENGTH 8
 #endif
 #ifndef  TRUMA_LOG_QUEUE_LENGTH
-#define TRUMA_LOG_QUEUE_LENGTH 6
+#define TRUMA_LOG_QUEUE_LENGTH 8
+#endif
+// Frames buffered for `add_on_lin_frame_callback` subscribers between two main loop runs.
+#ifndef  TRUMA_FRAME_QUEUE_LENGTH
+#define TRUMA_FRAME_QUEUE_LENGTH 16
+#endif
+#ifndef  TRUMA_RX_CHUNK_LENGTH
+#define TRUMA_RX_CHUNK_LENGTH 32
+#endif
+// LIN buses (listeners) per device.
+#ifndef  TRUMA_MAX_LIN_BUSES
+#define TRUMA_MAX_LIN_BUSES 4
+#endif
+// Valid frames with the same checksum model before a PID uses only this model.
+#ifndef  TRUMA_CHECKSUM_LEARN_FRAMES
+#define TRUMA_CHECKSUM_LEARN_FRAMES 4
+#endif
+// Broken frames in a row at a learned data length before the length of the PID is learned again.
+#ifndef  TRUMA_DATA_LENGTH_UNLEARN_FRAMES
+#define TRUMA_DATA_LENGTH_UNLEARN_FRAMES 4
 #endif
 
 namespace esphome {
@@ -27,10 +64,57 @@ namespace truma_inetbox {
 
 enum class LIN_CHECKSUM { LIN_CHECKSUM_VERSION_1, LIN_CHECKSUM_VERSION_2 };
 
+// Checksum models of a received frame, used as bit mask. Enhanced checksums include the PID: the CP Plus (master) sums
+// the PID without parity bits, slaves the PID with parity bits.
+static const u_int8_t LIN_CHECKSUM_MODEL_CLASSIC = 0x01;
+static const u_int8_t LIN_CHECKSUM_MODEL_ENHANCED_MASTER = 0x02;
+static const u_int8_t LIN_CHECKSUM_MODEL_ENHANCED_SLAVE = 0x04;
+static const u_int8_t LIN_CHECKSUM_MODEL_ALL = 0x07;
+
 struct QUEUE_LIN_MSG {
   u_int8_t current_PID;
   u_int8_t data[8];
   u_int8_t len;
+  // `data` is the armed answer for `current_PID` that was sent, not a received frame.
+  bool answer_sent;
+};
+
+enum class LIN_FRAME_SOURCE { LIN_FRAME_SOURCE_UNKNOWN, LIN_FRAME_SOURCE_MASTER, LIN_FRAME_SOURCE_SLAVE };
+
+// Received frame of either direction for `add_on_lin_frame_callback`.
+struct QUEUE_LIN_FRAME {
+  // `lin_micros()` of the PID.
+  uint32_t received_at;
+  u_int8_t current_PID;
+  u_int8_t data[8];
+  u_int8_t len;
+  u_int8_t checksum;
+  // Derived from the checksum model, or fixed for the diagnostic PIDs.
+  LIN_FRAME_SOURCE source;
+  bool checksum_valid;
+  // The response was our armed answer (echo of the LIN driver).
+  bool own_answer;
+};
+
+// Bus statistics of one PID since boot. Written by the receive path at constant cost per byte.
+struct LIN_PID_STATS {
+  // Headers of the PID, with or without response.
+  uint32_t frames = 0;
+  // Complete responses with a valid checksum.
+  uint32_t valid_frames = 0;
+  uint32_t sid_parity_errors = 0;
+  uint32_t crc_v1_errors = 0;
+  uint32_t crc_v2_errors = 0;
+  // Headers without response and responses shorter than the frame length.
+  uint32_t lost_frames = 0;
+  uint32_t partial_frames = 0;
+  // Headers answered by us.
+  uint32_t answered = 0;
+  // `lin_micros()` of the last header.
+  uint32_t last_seen = 0;
+  // Time between the last two headers and its smoothed deviation (1/16 per header, as RFC 3550) in microseconds.
+  uint32_t interval = 0;
+  uint32_t jitter = 0;
 };
 
 class LinBusListener : public PollingComponent, public uart::UARTDevice {
@@ -45,14 +129,108 @@ class LinBusListener : public PollingComponent, public uart::UARTDevice {
   void set_cs_pin(GPIOPin *pin) { this->cs_pin_ = pin; }
   void set_fault_pin(GPIOPin *pin) { this->fault_pin_ = pin; }
   void set_observer_mode(bool val) { this->observer_mode_ = val; }
+  // Follow the baud rate of the master measured from SYNC to PID: timeouts and the UART baud rate.
+  void set_baud_rate_tracking(bool val) { this->baud_rate_tracking_ = val; }
+  // Response space: send answers `us` after the stop bit of the PID instead of right away. Scheduled with the answer
+  // timer, the deviation from the deadline is measured in `get_response_jitter_histogram`.
+  void set_response_delay(uint32_t us) { this->response_delay_ = us; }
+  // ESP32: mark frame starts with the UART break detection instead of the received 0x00 byte.
+  void set_hardware_break(bool val) { this->hardware_break_ = val; }
+#if defined(USE_RP2040) || defined(USE_HOST)
+  // Receive and send with PIO state machines instead of the UART.
+  void set_pio(bool val) { this->pio_engine_ = val; }
+  void set_pio_pins(u_int8_t rx_pin, u_int8_t tx_pin) {
+    this->pio_rx_pin_ = rx_pin;
+    this->pio_tx_pin_ = tx_pin;
+  }
+#endif  // USE_RP2040 || USE_HOST
+#ifdef USE_ESP32_FRAMEWORK_ESP_IDF
+  // Replace the interrupt handler of the UART driver with an own one that runs the LIN state machine.
+  void set_uart_isr(bool val) { this->uart_isr_ = val; }
+#endif  // USE_ESP32_FRAMEWORK_ESP_IDF
+  // Number of data bytes (1..8) in frames of `pid`. Frames complete as soon as their checksum byte arrives.
+  void set_lin_data_length(u_int8_t pid, u_int8_t len) {
+    this->lin_data_length_[pid & 0x3F] = len;
+    this->lin_data_length_configured_ |= 1ull << (pid & 0x3F);
+  }
   bool get_lin_bus_fault() { return fault_on_lin_bus_reported_ > 3; }
+  LinBusQueueStats *get_lin_msg_queue_stats() { return &this->lin_msg_queue_; }
+  LinBusQueueStats *get_lin_frame_queue_stats() { return &this->lin_frame_queue_; }
+#if ESPHOME_LOG_LEVEL > ESPHOME_LOG_LEVEL_NONE
+  LinBusQueueStats *get_log_queue_stats() { return &this->log_queue_; }
+#else
+  LinBusQueueStats *get_log_queue_stats() { return nullptr; }
+#endif
+  // Measured bus timing in microseconds: 0x00 of the break to SYNC, PID to first response byte and gaps between
+  // response bytes.
+  LinBusHistogram *get_break_to_sync_histogram() { return &this->break_to_sync_; }
+  LinBusHistogram *get_header_to_response_histogram() { return &this->header_to_response_; }
+  LinBusHistogram *get_inter_byte_gap_histogram() { return &this->inter_byte_gap_; }
+  // Delay of answers sent by the answer timer after their deadline, in microseconds.
+  LinBusHistogram *get_response_jitter_histogram() { return &this->response_jitter_; }
+  // Baud rate of the master, `NAN` until measured.
+  float get_measured_baud_rate() const {
+    auto bit_time_q8 = this->measured_bit_time_q8_;
+    return bit_time_q8 == 0 ? NAN : 1000.0f * 1000.0f * 256.0f / bit_time_q8;
+  }
+  // Sent answers whose echo differed from the sent bytes, and the number of differing bits.
+  uint32_t get_lin_answer_collisions() const { return this->lin_answer_collisions_; }
+  uint32_t get_lin_answer_bit_errors() const { return this->lin_answer_bit_errors_; }
+  // Average CPU cycles spent in the receive path per UART byte.
+  float get_rx_cycles_per_byte() { return this->rx_bytes_ == 0 ? NAN : (float) this->rx_cycles_ / this->rx_bytes_; }
+
+  // Answer provider of a PID: writes up to 8 data bytes to `data` and returns their number, `0` to not answer. Called in
+  // the LIN message task whenever the answer of `pid` is not armed.
+  typedef u_int8_t (*lin_provider_t)(void *arg, u_int8_t pid, u_int8_t *data);
+  // Frame consumer of a PID: valid frames of the master. Called in the LIN message task.
+  typedef void (*lin_consumer_t)(void *arg, u_int8_t pid, const u_int8_t *message, u_int8_t length);
+  // Claim `pid` (without parity bits). Register before `setup()` of this component, one provider and one consumer per
+  // PID. Frames of PIDs without consumer are not queued for the LIN message task. `sent` is called in the LIN message
+  // task with the data of every sent answer of the provider.
+  bool register_lin_provider(u_int8_t pid, lin_provider_t provider, void *arg, lin_consumer_t sent = nullptr);
+  bool register_lin_consumer(u_int8_t pid, lin_consumer_t consumer, void *arg);
+  // Let the LIN message task call the provider of `pid` again and replace the armed answer if it changed. For
+  // providers that read state changed elsewhere, they must not have side effects. Callable from any task.
+  void refresh_lin_answer(u_int8_t pid);
+
+  // Receive every frame with a response, from master and slaves, including invalid ones. Callbacks run in the main
+  // loop. Frames are only queued once a callback is added.
+  void add_on_lin_frame_callback(std::function<void(const QUEUE_LIN_FRAME *)> &&callback);
+
+  // Statistics of `pid` (without parity bits).
+  const LIN_PID_STATS *get_lin_pid_stats(u_int8_t pid) const { return &this->lin_pid_stats_[pid & 0x3F]; }
+  // Log one line per PID seen on the bus.
+  void dump_lin_pid_stats();
+
+  // Last `TRUMA_TRACE_LENGTH` frames and headers of this bus, recorded at all times.
+  const LinBusTrace *get_lin_trace() const { return &this->lin_trace_; }
+  // Log the trace as hex lines of `LinTraceRecord`s for decoding off the device.
+  void dump_lin_trace();
+
+  // Runtime filter of the log messages of the receive path: bit `TRUMA_LOG_TYPE_BIT(type)` per `QUEUE_LOG_MSG_TYPE`
+  // and bit `1 << pid` per PID (without parity bits). All enabled by default. Types above the compiled log level are
+  // never produced.
+  void set_log_type_mask(uint32_t mask) { this->log_type_mask_.store(mask); }
+  void enable_log_type(QUEUE_LOG_MSG_TYPE type) { this->log_type_mask_.fetch_or(TRUMA_LOG_TYPE_BIT(type)); }
+  void set_log_pid_mask(uint64_t mask) {
+    this->log_pid_mask_[0].store((uint32_t) mask);
+    this->log_pid_mask_[1].store((uint32_t) (mask >> 32));
+  }
 
   void process_lin_msg_queue(TickType_t xTicksToWait);
+  void process_lin_frame_queue();
   void process_log_queue(TickType_t xTicksToWait);
 
+  // Listeners in order of setup. Entries are only appended, so interrupts and the RP2040 `loop1()` read them without
+  // a lock.
+  static size_t get_instance_count() { return instance_count_.load(); }
+  static LinBusListener *get_instance(size_t index) { return instances_[index]; }
+  u_int8_t get_bus_index() const { return this->bus_index_; }
+
 #ifdef USE_RP2040
-  // Return is the expected wait time till next data check is recommended.
-  u_int32_t onSerialEvent();
+  // Called from `loop1()` on core 1 after an interrupt. Closes timed out frames, sends delayed answers and handles LIN
+  // messages.
+  void onSerialEvent();
 #endif  // USE_RP2040
 
  protected:
@@ -60,11 +238,15 @@ class LinBusListener : public PollingComponent, public uart::UARTDevice {
   GPIOPin *cs_pin_ = nullptr;
   GPIOPin *fault_pin_ = nullptr;
   bool observer_mode_ = false;
+  bool hardware_break_ = false;
 
-  void write_lin_answer_(const u_int8_t *data, u_int8_t len);
+  bool is_lin_answer_armed_(const u_int8_t pid) const {
+    return this->lin_answers_[pid & 0x3F].state.load() != LIN_ANSWER_FREE;
+  }
+  // Take back the armed answer of `pid` before the receive path sends it. Call in the LIN message task. Returns `false`
+  // if the answer was not armed or is being sent. The next header of `pid` counts as not ready.
+  bool disarm_lin_answer_(const u_int8_t pid);
   bool check_for_lin_fault_();
-  virtual bool answer_lin_order_(const u_int8_t pid) = 0;
-  virtual void lin_message_recieved_(const u_int8_t pid, const u_int8_t *message, u_int8_t length) = 0;
 
  private:
   // Microseconds per UART Baud
@@ -80,9 +262,86 @@ class LinBusListener : public PollingComponent, public uart::UARTDevice {
   u_int32_t time_per_first_byte_;
   // Microseconds per UART Byte (UART Frame)
   u_int32_t time_per_byte_;
+  // Microseconds from PID to the end of the longest response (8 data bytes and checksum, 40% inter-byte space).
+  u_int32_t time_per_slot_;
 
   u_int8_t fault_on_lin_bus_reported_ = 0;
-  bool can_write_lin_answer_ = false;
+
+  static LinBusListener *instances_[TRUMA_MAX_LIN_BUSES];
+  static std::atomic<size_t> instance_count_;
+  u_int8_t bus_index_ = 0;
+  bool register_instance_();
+
+  // Answer to a master header. Written by the LIN message task while `LIN_ANSWER_FREE`. The receive path claims an
+  // `LIN_ANSWER_ARMED` answer to send it, the message task to disarm it.
+  enum lin_answer_state : u_int8_t {
+    LIN_ANSWER_FREE,
+    LIN_ANSWER_ARMED,
+    LIN_ANSWER_SENDING,
+  };
+  struct LIN_ANSWER {
+    std::atomic<u_int8_t> state{LIN_ANSWER_FREE};
+    // Answer was armed at least once. A header without an armed answer counts as not ready.
+    bool used = false;
+    u_int8_t len = 0;
+    // up to 8 byte data frame + CRC
+    u_int8_t data[9] = {};
+    // Echo of the LIN driver differed from the sent bytes.
+    uint32_t collisions = 0;
+    uint32_t bit_errors = 0;
+    // Fewer bytes than sent were read back.
+    uint32_t echo_missing = 0;
+  };
+  LIN_ANSWER lin_answers_[64];
+  // Prepare the answer to the next header of `pid`, including the checksum. Only call when `is_lin_answer_armed_(pid)`
+  // is false. The answer is sent once.
+  bool arm_lin_answer_(const u_int8_t pid, const u_int8_t *data, u_int8_t len);
+
+  // Dispatch table indexed by the PID without parity bits. Written before setup, read by the receive path and the LIN
+  // message task.
+  struct LIN_PID_HANDLER {
+    lin_provider_t provider = nullptr;
+    void *provider_arg = nullptr;
+    lin_consumer_t sent = nullptr;
+    lin_consumer_t consumer = nullptr;
+    void *consumer_arg = nullptr;
+  };
+  LIN_PID_HANDLER lin_pid_handlers_[64];
+  // PIDs with a provider in order of registration.
+  u_int8_t lin_provider_pids_[64] = {};
+  u_int8_t lin_provider_count_ = 0;
+  // Called in the LIN message task after a message was recieved or an armed answer was sent. Arm the next answers.
+  void lin_prepare_answers_();
+  // Bit `1 << pid` per PID (without parity bits) of `refresh_lin_answer`.
+  std::atomic<uint32_t> lin_answers_refresh_[2] = {0, 0};
+  void refresh_lin_answers_();
+  void wake_lin_msg_task_();
+  uint32_t lin_answers_sent_ = 0;
+  uint32_t lin_answers_not_ready_ = 0;
+  uint32_t lin_answer_collisions_ = 0;
+  uint32_t lin_answer_bit_errors_ = 0;
+  // Headers not answered because an answer collided earlier in the same slot.
+  uint32_t lin_answers_suppressed_ = 0;
+  // Bytes of the answer sent in the current frame, compared with the received echo.
+  u_int8_t tx_echo_[9] = {};
+  u_int8_t tx_echo_len_ = 0;
+  // After a collision no answer is sent before the longest possible frame slot (`time_per_slot_`) ended.
+  bool answer_blocked_ = false;
+  uint32_t answer_blocked_since_ = 0;
+  void check_lin_answer_echo_(u_int8_t buf);
+
+  uint32_t response_delay_ = 0;
+  // Sends the armed answer of the current frame at `answer_deadline_`.
+  LinBusTimer answer_timer_;
+  bool answer_scheduled_ = false;
+  uint32_t answer_deadline_ = 0;
+  // Scheduled answers not sent because another node answered first or the frame ended.
+  uint32_t lin_answers_preempted_ = 0;
+  LinBusHistogram response_jitter_{10};
+  static void answer_timer_callback_(void *args);
+  void handle_answer_timer_(uint32_t current);
+  // Send the armed answer of `current_PID_` and hand it back to the message task.
+  void send_lin_answer_(LIN_ANSWER *answer);
 
   enum read_state {
     READ_STATE_BREAK,
@@ -95,54 +354,230 @@ class LinBusListener : public PollingComponent, public uart::UARTDevice {
   u_int8_t current_PID_with_parity_ = 0x00;
   u_int8_t current_PID_ = 0x00;
   bool current_PID_order_answered_ = false;
+  // The echo of the answer in the current frame differed from the sent bytes.
+  bool current_answer_collision_ = false;
   bool current_data_valid = true;
   u_int8_t current_data_count_ = 0;
   // up to 8 byte data frame + CRC
   u_int8_t current_data_[9] = {};
+  // Expected data bytes per PID. `0` is unknown: the frame is read up to 8 data bytes or until the next BREAK, and the
+  // length is learned after two frames with a valid checksum at the same length.
+  u_int8_t lin_data_length_[64] = {};
+  u_int8_t lin_data_length_candidate_[64] = {};
+  // Bit `1 << pid` of lengths set by `set_lin_data_length` or the LIN specification. These are never learned again.
+  uint64_t lin_data_length_configured_ = 0;
+  // Checksum errors and partial frames in a row at the learned length.
+  u_int8_t lin_data_length_errors_[64] = {};
+  // Checksum model per PID, `0` until learned. Frames of a learned PID are only checked against this model.
+  u_int8_t lin_checksum_model_[64] = {};
+  u_int8_t lin_checksum_model_candidate_[64] = {};
+  u_int8_t lin_checksum_model_votes_[64] = {};
+  // Frames of a PID with learned model that did not match it.
+  uint32_t lin_checksum_deviations_ = 0;
+  LIN_PID_STATS lin_pid_stats_[64];
+  // Count the header of `current_PID_` at `current`.
+  void count_lin_header_(uint32_t current);
   // // Time when the last LIN data was available.
   uint32_t last_data_recieved_ = 0;
+  // Closes a frame `time_per_first_byte_` after its last byte, even if no further data arrives.
+  LinBusTimer frame_timer_;
+  uint32_t frame_timeouts_ = 0;
+#ifdef USE_ESP32
+  // Serialises the receive path and the timers (esp_timer task). Only the receive path waits for it.
+  SemaphoreHandle_t frame_mutex_ = nullptr;
+  // Give `frame_mutex_` and handle the timers that fired while it was held.
+  void frame_mutex_give_();
+  void handle_pending_timers_();
+#endif  // USE_ESP32
+#if defined(USE_ESP32) || defined(USE_RP2040)
+  // Set by the timers, handled by the holder of `frame_mutex_` (ESP32) or in `onSerialEvent` (RP2040).
+  std::atomic<bool> frame_timeout_pending_{false};
+  std::atomic<bool> answer_timer_pending_{false};
+#endif  // USE_ESP32 || USE_RP2040
+  // Receive path cost for `get_rx_cycles_per_byte`.
+  uint64_t rx_cycles_ = 0;
+  uint32_t rx_bytes_ = 0;
+
+  // Hardware break detection: the current frame started with a detected break.
+  bool current_frame_break_detected_ = false;
+  // A break was detected before its 0x00 was read. Kept over `current_state_reset_()` for the next frame start.
+  bool hardware_break_pending_ = false;
+  // Last byte of the last received chunk.
+  u_int8_t last_rx_byte_ = 0xFF;
+  uint32_t hardware_breaks_ = 0;
+  uint32_t hardware_break_resyncs_ = 0;
+
+  LinFrame current_frame_;
+  // The current byte was the last of its chunk, its timestamp is not estimated.
+  bool rx_byte_exact_ = false;
+  // Bytes are read from a buffer some time after they arrived (PIO DMA ring). Frames end at a break or the frame timer,
+  // not at a gap before a byte.
+  bool rx_buffered_ = false;
+
+  bool baud_rate_tracking_ = false;
+  // Bit time of the master in 1/256 us, averaged over SYNC to PID times. 0 until measured.
+  uint32_t measured_bit_time_q8_ = 0;
+  uint32_t bit_time_samples_ = 0;
+  // Baud rate the timeouts and the UART are set to.
+  uint32_t applied_baud_rate_ = 0;
+  void track_bit_time_(uint32_t sync_to_pid);
+  void set_timing_(uint32_t baud_rate);
+  void apply_measured_baud_rate_();
+  // Reconfigure the UART (or PIO) to `baud_rate`. Called from the main loop.
+  void set_framework_baud_rate_(uint32_t baud_rate);
+  LinBusHistogram break_to_sync_;
+  LinBusHistogram header_to_response_;
+  LinBusHistogram inter_byte_gap_;
 
   void current_state_reset_() {
     this->current_state_ = READ_STATE_BREAK;
+    this->current_frame_break_detected_ = false;
     this->current_PID_with_parity_ = 0x00;
     this->current_PID_ = 0x00;
     this->current_PID_order_answered_ = false;
+    this->current_answer_collision_ = false;
+    this->answer_scheduled_ = false;
     this->current_data_valid = true;
     this->current_data_count_ = 0;
     memset(this->current_data_, 0, sizeof(this->current_data_));
+    this->current_frame_ = LinFrame();
   };
   void onReceive_();
-  void read_lin_frame_();
+  // Called by the UART backend for a detected break, after the data received before it.
+  void onHardwareBreak_();
+  void handle_hardware_break_();
+  void read_lin_chunk_(const u_int8_t *buf, size_t len);
+  // Byte with its hardware break flag.
+  void read_lin_byte_(u_int8_t data, bool is_break);
+#if defined(USE_RP2040) || defined(USE_HOST)
+  // Word of the `lin_rx` FIFO read at `current`, followed by `words_after` words read at once.
+  void read_lin_pio_word_(uint32_t word, uint32_t current, uint32_t words_after);
+#endif  // USE_RP2040 || USE_HOST
+  void read_lin_frame_(u_int8_t buf, uint32_t current);
+  void start_frame_timer_();
+  static void frame_timer_callback_(void *args);
+  void handle_frame_timeout_(uint32_t current);
+  void close_lin_frame_();
+  u_int8_t expected_frame_length_() const;
+  bool learn_lin_data_length_();
+  // Frame of `current_PID_` broken at its learned length. Forgets the length after `TRUMA_DATA_LENGTH_UNLEARN_FRAMES`.
+  void count_lin_data_length_error_();
+  // Models out of `models` whose checksum matches the current frame.
+  u_int8_t match_lin_checksum_(u_int8_t data_length, u_int8_t models) const;
+  void learn_lin_checksum_model_(u_int8_t models);
+  void finish_lin_frame_();
+  void write_lin_answer_();
   void clear_uart_buffer_();
   void setup_framework();
 
-  uint8_t lin_msg_static_queue_storage[TRUMA_MSG_QUEUE_LENGTH * sizeof(QUEUE_LIN_MSG)];
-  StaticQueue_t lin_msg_static_queue_;
-  QueueHandle_t lin_msg_queue_ =
-      xQueueCreateStatic(/* uxQueueLength */ TRUMA_MSG_QUEUE_LENGTH,
-                         /* uxItemSize */ sizeof(QUEUE_LIN_MSG),
-                         /* pucQueueStorageBuffer */ lin_msg_static_queue_storage, &lin_msg_static_queue_);
+  LinBusQueue<QUEUE_LIN_MSG, TRUMA_MSG_QUEUE_LENGTH> lin_msg_queue_;
+  void lin_msg_queue_push_(const QUEUE_LIN_MSG &lin_msg);
+
+  // Set by the first `add_on_lin_frame_callback`, the receive path skips the frame queue until then.
+  std::atomic<bool> lin_frame_subscribed_{false};
+  LinBusQueue<QUEUE_LIN_FRAME, TRUMA_FRAME_QUEUE_LENGTH> lin_frame_queue_;
+  CallbackManager<void(const QUEUE_LIN_FRAME *)> lin_frame_callback_{};
+  void lin_frame_queue_push_(u_int8_t data_length, bool checksum_valid, LIN_FRAME_SOURCE source);
+
+  LinBusTrace lin_trace_;
+  // Add the current frame to `lin_trace_`. Flags of the answer, the break and the SID parity are added.
+  void trace_lin_frame_(u_int8_t flags);
+
+  std::atomic<uint32_t> log_type_mask_{0xFFFFFFFF};
+  std::atomic<uint32_t> log_pid_mask_[2] = {0xFFFFFFFF, 0xFFFFFFFF};
+  bool log_enabled_(QUEUE_LOG_MSG_TYPE type, u_int8_t pid) const {
+    auto type_bit = TRUMA_LOG_TYPE_BIT(type);
+    if ((this->log_type_mask_.load(std::memory_order_relaxed) & type_bit) == 0) {
+      return false;
+    }
+    pid &= 0x3F;
+    return (type_bit & QUEUE_LOG_MSG_TYPES_WITHOUT_PID) ||
+           ((this->log_pid_mask_[pid >> 5].load(std::memory_order_relaxed) >> (pid & 0x1F)) & 1);
+  }
 
 #if ESPHOME_LOG_LEVEL > ESPHOME_LOG_LEVEL_NONE
-  uint8_t log_static_queue_storage[TRUMA_LOG_QUEUE_LENGTH * sizeof(QUEUE_LOG_MSG)];
-  StaticQueue_t log_static_queue_;
-  QueueHandle_t log_queue_ =
-      xQueueCreateStatic(/* uxQueueLength */ TRUMA_LOG_QUEUE_LENGTH,
-                         /* uxItemSize */ sizeof(QUEUE_LOG_MSG),
-                         /* pucQueueStorageBuffer */ log_static_queue_storage, &log_static_queue_);
+  LinBusQueue<QUEUE_LOG_MSG, TRUMA_LOG_QUEUE_LENGTH> log_queue_;
+  // Warning or error being coalesced. `type` is `UNKNOWN` for a free slot.
+  struct LOG_COALESCE_SLOT {
+    QUEUE_LOG_MSG_TYPE type = QUEUE_LOG_MSG_TYPE::UNKNOWN;
+    u_int8_t current_PID = 0;
+    // Length of the last message. Lost messages without and with data are coalesced separately.
+    u_int8_t len = 0;
+    uint16_t repeats = 0;
+    uint32_t since = 0;
+    uint32_t last_at = 0;
+  };
+  LOG_COALESCE_SLOT log_coalesce_[TRUMA_LOG_COALESCE_SLOTS];
+  // Messages counted in a summary instead of queued.
+  uint32_t log_coalesced_ = 0;
+  void log_queue_push_coalesced_(const QUEUE_LOG_MSG &log_msg);
+  // Queue the summary of `slot` if it has repeats and free it.
+  void flush_log_coalesce_slot_(LOG_COALESCE_SLOT *slot);
+  // Called for every header: summarise slots whose window ended, even if the message does not occur again.
+  void flush_log_coalesce_(uint32_t current);
 #endif
 
 #ifdef USE_ESP32
-  TaskHandle_t eventTaskHandle_;
+  TaskHandle_t eventTaskHandle_ = nullptr;
   static void eventTask_(void *args);
 #endif  // USE_ESP32
 #ifdef USE_ESP32_FRAMEWORK_ESP_IDF
   TaskHandle_t uartEventTaskHandle_;
   static void uartEventTask_(void *args);
+  bool uart_isr_ = false;
+  uart_port_t uart_num_ = UART_NUM_0;
+  intr_handle_t uart_isr_handle_ = nullptr;
+  // Serialises the UART interrupt and the timers when `uart_isr_` is used.
+  portMUX_TYPE frame_spinlock_ = portMUX_INITIALIZER_UNLOCKED;
+  // No FreeRTOS calls inside `frame_spinlock_`: the LIN message task is woken when it is given.
+  bool lin_msg_wake_pending_ = false;
+  void frame_spinlock_take_();
+  void frame_spinlock_give_();
+  static void uartIsr_(void *args);
 #endif  // USE_ESP32_FRAMEWORK_ESP_IDF
+#if defined(USE_RP2040) || defined(USE_HOST)
+  bool pio_engine_ = false;
+  u_int8_t pio_rx_pin_ = 0;
+  u_int8_t pio_tx_pin_ = 0;
+  // Read the words `lin_rx` received since the last call. Called at the PID (`lin_rx` IRQ) and by the frame and answer
+  // timers.
+  void pio_drain_();
+  // Words read from the RX DMA ring and words overwritten before they were read.
+  LinBusQueueStats pio_rx_ring_stats_;
+#endif  // USE_RP2040 || USE_HOST
+#ifdef USE_HOST
+  LinBusPioModel pio_model_;
+  // `lin_micros()` of the last bytes fed to `pio_model_`.
+  uint32_t pio_model_fed_at_ = 0;
+  bool pio_model_fed_ = false;
+#endif  // USE_HOST
 #ifdef USE_RP2040
   u_int8_t uart_number_ = 0;
   uart_inst_t *uart_ = nullptr;
+  // UART or PIO interrupt of the receive path, enabled on core 1.
+  uint irq_num_ = 0;
+  bool irq_enabled_ = false;
+  PIO pio_ = nullptr;
+  uint pio_rx_sm_ = 0;
+  uint pio_tx_sm_ = 0;
+  int pio_rx_dma_ = -1;
+  int pio_tx_dma_ = -1;
+  // Written by DMA from the `lin_rx` FIFO. Aligned to its size for the DMA ring.
+  alignas(128) uint32_t pio_rx_ring_[LIN_PIO_RX_RING_WORDS] = {};
+  uint32_t pio_rx_pos_ = 0;
+  // DMA transfer count at the last read. Unlike the write address it shows when the ring was lapped.
+  uint32_t pio_rx_dma_remaining_ = 0xFFFFFFFF;
+  bool setup_pio_();
+  static void pio_irq_handler_();
+  // Answer being sent by the TX interrupt.
+  u_int8_t tx_data_[9] = {};
+  u_int8_t tx_len_ = 0;
+  u_int8_t tx_pos_ = 0;
+  void uart_irq_();
+  void uart_tx_start_(const u_int8_t *data, u_int8_t len);
+  void uart_tx_continue_();
+  static void uart0_irq_handler_();
+  static void uart1_irq_handler_();
 #endif  // USE_RP2040
 };
 
@@ -34,6 +34,10 @@ void LinBusListener::setup_framework() {
       UART_RXFIFO_FULL_INT_ENA_M | UART_RXFIFO_TOUT_INT_ENA_M;  // only these IRQs - no BREAK, PARITY or OVERFLOW
   // UART_RXFIFO_FULL_INT_ENA_M | UART_RXFIFO_TOUT_INT_ENA_M | UART_FRM_ERR_INT_ENA_M |
   // UART_RXFIFO_OVF_INT_ENA_M | UART_BRK_DET_INT_ENA_M | UART_PARITY_ERR_INT_ENA_M;
+  if (this->hardware_break_) {
+    // Break detection raises `UART_BREAK_ERROR`.
+    uart_intr.intr_enable_mask |= UART_BRK_DET_INT_ENA_M;
+  }
   uart_intr.rxfifo_full_thresh =
       1;  // UART_FULL_THRESH_DEFAULT,  //120 default!! aghh! need receive 120 chars before we see them
   uart_intr.rx_timeout_thresh =
@@ -43,6 +47,11 @@ void LinBusListener::setup_framework() {
 
   hw_serial->onReceive([this]() { this->onReceive_(); }, false);
   hw_serial->onReceiveError([this](hardwareSerial_error_t val) {
+    if (val == UART_BREAK_ERROR && this->hardware_break_) {
+      // Keep the buffer, it holds the SYNC and PID of this frame.
+      this->onHardwareBreak_();
+      return;
+    }
     // Ignore any data present in buffer
     this->clear_uart_buffer_();
     if (val == UART_BREAK_ERROR) {
@@ -55,9 +64,11 @@ void LinBusListener::setup_framework() {
     }
   });
 
-  // Creating LIN msg event Task
+  // Creating LIN msg event Task. Every LIN bus has its own task.
+  char task_name[configMAX_TASK_NAME_LEN];
+  snprintf(task_name, sizeof(task_name), "lin_event%d", uart_num);
   xTaskCreatePinnedToCore(LinBusListener::eventTask_,
-                          "lin_event_task",         // name
+                          task_name,                // name
                           4096,                     // stack size (in words)
                           this,                     // input params
                           2,                        // priority
@@ -70,6 +81,11 @@ void LinBusListener::setup_framework() {
   }
 }
 
+void LinBusListener::set_framework_baud_rate_(uint32_t baud_rate) {
+  auto uartComp = static_cast<ESPHOME_UART *>(this->parent_);
+  uartComp->get_hw_serial()->updateBaudRate(baud_rate);
+}
+
 void LinBusListener::eventTask_(void *args) {
   LinBusListener *instance = (LinBusListener *) args;
   for (;;) {
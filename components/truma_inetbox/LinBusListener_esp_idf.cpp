@@ -2,6 +2,8 @@
 #include "LinBusListener.h"
 #include "esphome/core/log.h"
 #include "soc/uart_reg.h"
+#include "hal/uart_ll.h"
+#include "esp_idf_version.h"
 #ifdef CUSTOM_ESPHOME_UART
 #include "esphome/components/uart/truma_uart_component_esp_idf.h"
 #define ESPHOME_UART uart::truma_IDFUARTComponent
@@ -16,41 +18,77 @@ namespace truma_inetbox {
 static const char *const TAG = "truma_inetbox.LinBusListener";
 
 #define QUEUE_WAIT_BLOCKING (portTickType) portMAX_DELAY
+// `uart_isr_register` was removed in ESP-IDF 5.
+#define UART_ISR_SUPPORTED (ESP_IDF_VERSION_MAJOR < 5)
 
 void LinBusListener::setup_framework() {
   // uartSetFastReading
   auto uartComp = static_cast<ESPHOME_UART *>(this->parent_);
 
   auto uart_num = uartComp->get_hw_serial_number();
+  this->uart_num_ = (uart_port_t) uart_num;
 
   // Tweak the fifo settings so data is available as soon as the first byte is recieved.
   // If not it will wait either until fifo is filled or a certain time has passed.
   uart_intr_config_t uart_intr;
   uart_intr.intr_enable_mask =
       UART_RXFIFO_FULL_INT_ENA_M | UART_RXFIFO_TOUT_INT_ENA_M;  // only these IRQs - no BREAK, PARITY or OVERFLOW
+  if (this->hardware_break_) {
+    // Break detection raises `UART_BREAK` events.
+    uart_intr.intr_enable_mask |= UART_BRK_DET_INT_ENA_M;
+  }
   uart_intr.rxfifo_full_thresh =
       1;  // UART_FULL_THRESH_DEFAULT,  //120 default!! aghh! need receive 120 chars before we see them
   uart_intr.rx_timeout_thresh =
       10;  // UART_TOUT_THRESH_DEFAULT,  //10 works well for my short messages I need send/receive
   uart_intr.txfifo_empty_intr_thresh = 10;  // UART_EMPTY_THRESH_DEFAULT
-  uart_intr_config(uart_num, &uart_intr);
 
-  // Creating UART event Task
-  xTaskCreatePinnedToCore(LinBusListener::uartEventTask_,
-                          "uart_event_task",                      // name
-                          ARDUINO_SERIAL_EVENT_TASK_STACK_SIZE,   // stack size (in words)
-                          this,                                   // input params
-                          24,                                     // priority
-                          &this->uartEventTaskHandle_,            // handle
-                          ARDUINO_SERIAL_EVENT_TASK_RUNNING_CORE  // core
-  );
-  if (this->uartEventTaskHandle_ == NULL) {
-    ESP_LOGE(TAG, " -- UART%d Event Task not created!", uart_num);
+#if UART_ISR_SUPPORTED
+  if (this->uart_isr_) {
+    // Replace only the interrupt handler of the driver. `uart_driver_delete` would also disable the UART module. The
+    // driver stays installed, so clock, pins, baud rate and frame format stay configured. Its buffers are no longer
+    // served.
+    if (uart_isr_free(this->uart_num_) != ESP_OK ||
+        uart_isr_register(this->uart_num_, LinBusListener::uartIsr_, this, 0, &this->uart_isr_handle_) != ESP_OK) {
+      ESP_LOGE(TAG, " -- UART%d interrupt handler not registered!", uart_num);
+      this->mark_failed();
+      return;
+    }
+    uart_intr_config(this->uart_num_, &uart_intr);
+  }
+#else
+  if (this->uart_isr_) {
+    // Rejected by the config validation.
+    ESP_LOGE(TAG, "UART interrupt handler requires ESP-IDF 4.");
+    this->mark_failed();
+    return;
+  }
+#endif  // UART_ISR_SUPPORTED
+
+  if (!this->uart_isr_) {
+    uart_intr_config(uart_num, &uart_intr);
+
+    // Creating UART event Task
+    char uart_task_name[configMAX_TASK_NAME_LEN];
+    snprintf(uart_task_name, sizeof(uart_task_name), "uart_event%d", uart_num);
+    xTaskCreatePinnedToCore(LinBusListener::uartEventTask_,
+                            uart_task_name,                         // name
+                            ARDUINO_SERIAL_EVENT_TASK_STACK_SIZE,   // stack size (in words)
+                            this,                                   // input params
+                            24,                                     // priority
+                            &this->uartEventTaskHandle_,            // handle
+                            ARDUINO_SERIAL_EVENT_TASK_RUNNING_CORE  // core
+    );
+    if (this->uartEventTaskHandle_ == NULL) {
+      ESP_LOGE(TAG, " -- UART%d Event Task not created!", uart_num);
+    }
   }
 
-  // Creating LIN msg event Task
+  // Creating LIN msg event Task. Every LIN bus has its own task.
+  char task_name[configMAX_TASK_NAME_LEN];
+  snprintf(task_name, sizeof(task_name), "lin_event%d", uart_num);
   xTaskCreatePinnedToCore(LinBusListener::eventTask_,
-                          "lin_event_task",                       // name
+                          task_name,                              // name
                           ARDUINO_SERIAL_EVENT_TASK_STACK_SIZE,   // stack size (in words)
                           this,                                   // input params
                           2,                                      // priority
@@ -63,6 +101,11 @@ void LinBusListener::setup_framework() {
   }
 }
 
+void LinBusListener::set_framework_baud_rate_(uint32_t baud_rate) {
+  // Works with the driver's and with the own interrupt handler (`uart_isr_`).
+  uart_set_baudrate(this->uart_num_, baud_rate);
+}
+
 void LinBusListener::uartEventTask_(void *args) {
   LinBusListener *instance = (LinBusListener *) args;
   auto uartComp = static_cast<ESPHOME_UART *>(instance->parent_);
@@ -74,6 +117,9 @@ void LinBusListener::uartEventTask_(void *args) {
     if (xQueueReceive(*uartEventQueue, (void *) &event, QUEUE_WAIT_BLOCKING)) {
       if (event.type == UART_DATA && instance->available() > 0) {
         instance->onReceive_();
+      } else if (event.type == UART_BREAK && instance->hardware_break_) {
+        // Data before the break was handled by the previous `UART_DATA` event.
+        instance->onHardwareBreak_();
       } else if (event.type == UART_BREAK) {
         // If the break is valid the `onReceive` is called first and the break is handeld. Therfore the expectation is
         // that the state should be in waiting for `SYNC`.
@@ -86,6 +132,47 @@ void LinBusListener::uartEventTask_(void *args) {
   vTaskDelete(NULL);
 }
 
+#if UART_ISR_SUPPORTED
+// Runs the LIN state machine directly on the bytes in the RX FIFO, without the driver's event queue and task.
+void IRAM_ATTR LinBusListener::uartIsr_(void *args) {
+  LinBusListener *instance = (LinBusListener *) args;
+  uart_dev_t *hw = UART_LL_GET_HW(instance->uart_num_);
+  auto status = uart_ll_get_intsts_mask(hw);
+  uart_ll_clr_intsts_mask(hw, status);
+
+  instance->frame_spinlock_take_();
+  if (status & (UART_RXFIFO_FULL_INT_ST_M | UART_RXFIFO_TOUT_INT_ST_M)) {
+    auto start_cycles = arch_get_cpu_cycle_count();
+    u_int8_t buf[TRUMA_RX_CHUNK_LENGTH];
+    uint32_t bytes = 0;
+    uint32_t len;
+    while ((len = uart_ll_get_rxfifo_len(hw)) > 0) {
+      if (len > sizeof(buf)) {
+        len = sizeof(buf);
+      }
+      uart_ll_read_rxfifo(hw, buf, len);
+      if (instance->get_lin_bus_fault()) {
+        // Ignore any data present in buffer
+        instance->current_state_reset_();
+        continue;
+      }
+      instance->read_lin_chunk_(buf, len);
+      bytes += len;
+    }
+    if (bytes > 0) {
+      instance->start_frame_timer_();
+    }
+    instance->rx_cycles_ += arch_get_cpu_cycle_count() - start_cycles;
+    instance->rx_bytes_ += bytes;
+  }
+  if ((status & UART_BRK_DET_INT_ST_M) && instance->hardware_break_) {
+    instance->handle_hardware_break_();
+  }
+  // Wakes the LIN message task after the critical section.
+  instance->frame_spinlock_give_();
+}
+#endif  // UART_ISR_SUPPORTED
+
 void LinBusListener::eventTask_(void *args) {
   LinBusListener *instance = (LinBusListener *) args;
   for (;;) {
@@ -97,6 +184,7 @@ void LinBusListener::eventTask_(void *args) {
 }  // namespace esphome
 
 #undef QUEUE_WAIT_BLOCKING
+#undef UART_ISR_SUPPORTED
 #undef ESPHOME_UART
 
 #endif  // USE_ESP32_FRAMEWORK_ESP_IDF
\ No newline at end of file
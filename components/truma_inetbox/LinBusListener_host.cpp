@@ -0,0 +1,88 @@
+#ifdef USE_HOST
+#include "LinBusListener.h"
+#include "esphome/core/log.h"
+#include "esphome/components/uart/uart_component_host.h"
+
+namespace esphome {
+namespace truma_inetbox {
+
+static const char *const TAG = "truma_inetbox.LinBusListener";
+
+#define QUEUE_WAIT_DONT_BLOCK (TickType_t) 0
+
+void LinBusListener::setup_framework() {
+  auto uartComp = static_cast<uart::HostUartComponent *>(this->parent_);
+
+  // There is no interrupt or second core. Data injected by the simulation is handled synchronously, the same way
+  // `loop1()` does it on RP2040.
+  if (this->pio_engine_) {
+    // Replay the injected bytes as line waveform through the `lin_rx` model.
+    uartComp->set_on_receive([this]() {
+      // Handle `refresh_lin_answer` requests of the main loop before the header.
+      this->process_lin_msg_queue(QUEUE_WAIT_DONT_BLOCK);
+      // The simulation injects a break as 0x00 at the start of a frame, after the line was idle. Frames may be injected
+      // at once or byte by byte.
+      bool first =
+          !this->pio_model_fed_ || lin_time_reached(lin_micros(), this->pio_model_fed_at_ + this->time_per_first_byte_);
+      auto irqs = this->pio_model_.irqs;
+      u_int8_t data;
+      while (this->available() && this->read_byte(&data)) {
+        if (first && data == 0x00) {
+          this->pio_model_.feed_break();
+        } else {
+          this->pio_model_.feed_byte(data);
+        }
+        first = false;
+      }
+      this->pio_model_fed_at_ = lin_micros();
+      this->pio_model_fed_ = true;
+      this->pio_model_.feed_idle(2);
+      // Like the DMA ring on RP2040 the words are only read at the PID. Response bytes wait for the frame timer.
+      if (this->pio_model_.irqs != irqs) {
+        this->pio_drain_();
+      }
+      this->process_lin_msg_queue(QUEUE_WAIT_DONT_BLOCK);
+    });
+    this->rx_buffered_ = true;
+    ESP_LOGD(TAG, "Using in-memory UART, PIO model and virtual clock.");
+    return;
+  }
+  uartComp->set_on_receive([this]() {
+    // Handle `refresh_lin_answer` requests of the main loop before the header.
+    this->process_lin_msg_queue(QUEUE_WAIT_DONT_BLOCK);
+    this->onReceive_();
+    this->process_lin_msg_queue(QUEUE_WAIT_DONT_BLOCK);
+  });
+  ESP_LOGD(TAG, "Using in-memory UART and virtual clock.");
+}
+
+void LinBusListener::pio_drain_() {
+  auto current = lin_micros();
+  uint32_t words = this->pio_model_.rx_fifo.size();
+  if (words >= LIN_PIO_RX_RING_WORDS) {
+    // The RP2040 DMA ring would have overwritten unread words.
+    this->pio_rx_ring_stats_.count_read(0, words);
+    this->pio_model_.rx_fifo.clear();
+    this->current_state_reset_();
+    return;
+  }
+  this->pio_rx_ring_stats_.count_read(words, 0);
+  for (uint32_t i = 0; i < words; i++) {
+    this->read_lin_pio_word_(this->pio_model_.rx_fifo[i], current, words - 1 - i);
+  }
+  this->pio_model_.rx_fifo.clear();
+  if (words > 0) {
+    this->start_frame_timer_();
+  }
+}
+
+void LinBusListener::set_framework_baud_rate_(uint32_t baud_rate) {
+  // The in-memory UART has no bit timing. Only the timeouts follow the master.
+}
+
+}  // namespace truma_inetbox
+}  // namespace esphome
+
+#undef QUEUE_WAIT_DONT_BLOCK
+
+#endif  // USE_HOST
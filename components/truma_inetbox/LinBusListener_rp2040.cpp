@@ -9,11 +9,8 @@
 #endif // CUSTOM_ESPHOME_UART
 #include "esphome/components/uart/uart_component_rp2040.h"
 #include <SerialUART.h>
-
-// Instance 1 for UART port 0
-static esphome::truma_inetbox::LinBusListener *LIN_BUS_LISTENER_INSTANCE_1 = nullptr;
-// Instance 2 for UART port 1
-static esphome::truma_inetbox::LinBusListener *LIN_BUS_LISTENER_INSTANCE_2 = nullptr;
+#include <hardware/clocks.h>
+#include <hardware/gpio.h>
 
 namespace esphome {
 namespace truma_inetbox {
@@ -25,67 +22,312 @@ static const char *const TAG = "truma_inetbox.LinBusListener";
 void LinBusListener::setup_framework() {
   auto uartComp = static_cast<ESPHOME_UART *>(this->parent_);
   auto is_hw_serial = uartComp->is_hw_serial();
-  if (!is_hw_serial) {
-    ESP_LOGW(TAG, "Must use hardware serial SerialPIO is not supported.");
-    this->mark_failed();
-  }
   // auto hw_serial = static_cast<SerialUART *>(uartComp->get_hw_serial());
   auto hw_serial = uartComp->get_hw_serial();
 
-  if ((*hw_serial) == Serial1) {
-    LIN_BUS_LISTENER_INSTANCE_1 = this;
-    this->uart_number_ = 1;
-    this->uart_ = uart0;
+  if (this->pio_engine_) {
+    // The PIO engine drives the pins itself.
+    if (is_hw_serial) {
+      hw_serial->end();
+    }
+    if (!this->setup_pio_()) {
+      ESP_LOGW(TAG, "No free PIO state machines or DMA channels.");
+      this->mark_failed();
+      return;
+    }
+    // Response bytes stay in the DMA ring until the frame timer, the PIO IRQ only fires at the PID.
+    this->rx_buffered_ = true;
+  } else {
+    if (!is_hw_serial) {
+      ESP_LOGW(TAG, "Must use hardware serial SerialPIO is not supported.");
+      this->mark_failed();
+    }
+
+    if ((*hw_serial) == Serial1) {
+      this->uart_number_ = 1;
+      this->uart_ = uart0;
+
+    } else if ((*hw_serial) == Serial2) {
+      this->uart_number_ = 2;
+      this->uart_ = uart1;
+    }
 
-  } else if ((*hw_serial) == Serial2) {
-    LIN_BUS_LISTENER_INSTANCE_2 = this;
-    this->uart_number_ = 2;
-    this->uart_ = uart1;
+    if (this->uart_ != nullptr) {
+      // Turn off FIFO's - we want to do this character by character. With FIFO the RX interrupt fires at 4 bytes or
+      // after 32 bit times, too late to answer the PID.
+      uart_set_fifo_enabled(this->uart_, false);
+
+      // Take the UART interrupt from `SerialUART`. It is enabled on core 1 by `onSerialEvent`.
+      this->irq_num_ = this->uart_ == uart0 ? UART0_IRQ : UART1_IRQ;
+      irq_set_enabled(this->irq_num_, false);
+      auto handler = irq_get_exclusive_handler(this->irq_num_);
+      if (handler != nullptr) {
+        irq_remove_handler(this->irq_num_, handler);
+      }
+      irq_set_exclusive_handler(this->irq_num_, this->uart_ == uart0 ? LinBusListener::uart0_irq_handler_
+                                                                    : LinBusListener::uart1_irq_handler_);
+    }
   }
+}
 
-  if (this->uart_ != nullptr) {
-    // Turn off FIFO's - we want to do this character by character
-    uart_set_fifo_enabled(this->uart_, false);
+bool LinBusListener::setup_pio_() {
+  pio_program_t rx_program = {LIN_PIO_RX_PROGRAM, sizeof(LIN_PIO_RX_PROGRAM) / sizeof(LIN_PIO_RX_PROGRAM[0]), -1};
+  pio_program_t tx_program = {LIN_PIO_TX_PROGRAM, sizeof(LIN_PIO_TX_PROGRAM) / sizeof(LIN_PIO_TX_PROGRAM[0]), -1};
+  for (auto pio : {pio0, pio1}) {
+    if (pio_can_add_program(pio, &rx_program) && pio_can_add_program(pio, &tx_program)) {
+      this->pio_ = pio;
+      break;
+    }
+  }
+  if (this->pio_ == nullptr) {
+    return false;
   }
+  auto rx_sm = pio_claim_unused_sm(this->pio_, false);
+  auto tx_sm = pio_claim_unused_sm(this->pio_, false);
+  this->pio_rx_dma_ = dma_claim_unused_channel(false);
+  this->pio_tx_dma_ = dma_claim_unused_channel(false);
+  if (rx_sm < 0 || tx_sm < 0 || this->pio_rx_dma_ < 0 || this->pio_tx_dma_ < 0) {
+    return false;
+  }
+  this->pio_rx_sm_ = rx_sm;
+  this->pio_tx_sm_ = tx_sm;
+  auto rx_offset = pio_add_program(this->pio_, &rx_program);
+  auto tx_offset = pio_add_program(this->pio_, &tx_program);
+  float clkdiv = (float) clock_get_hz(clk_sys) / (8 * this->parent_->get_baud_rate());
+
+  // Receiver: 8 cycles per bit, the stop bit is tested with `jmp pin`.
+  pio_gpio_init(this->pio_, this->pio_rx_pin_);
+  gpio_pull_up(this->pio_rx_pin_);
+  pio_sm_set_consecutive_pindirs(this->pio_, this->pio_rx_sm_, this->pio_rx_pin_, 1, false);
+  auto rx_config = pio_get_default_sm_config();
+  sm_config_set_wrap(&rx_config, rx_offset + LIN_PIO_RX_WRAP_TARGET, rx_offset + LIN_PIO_RX_WRAP);
+  sm_config_set_in_pins(&rx_config, this->pio_rx_pin_);
+  sm_config_set_jmp_pin(&rx_config, this->pio_rx_pin_);
+  sm_config_set_in_shift(&rx_config, true, false, 32);
+  sm_config_set_fifo_join(&rx_config, PIO_FIFO_JOIN_RX);
+  sm_config_set_clkdiv(&rx_config, clkdiv);
+  pio_sm_init(this->pio_, this->pio_rx_sm_, rx_offset, &rx_config);
+
+  // Transmitter: the line idles high through the side-set of `pull`.
+  pio_sm_set_pins_with_mask(this->pio_, this->pio_tx_sm_, 1u << this->pio_tx_pin_, 1u << this->pio_tx_pin_);
+  pio_sm_set_pindirs_with_mask(this->pio_, this->pio_tx_sm_, 1u << this->pio_tx_pin_, 1u << this->pio_tx_pin_);
+  pio_gpio_init(this->pio_, this->pio_tx_pin_);
+  auto tx_config = pio_get_default_sm_config();
+  sm_config_set_wrap(&tx_config, tx_offset + LIN_PIO_TX_WRAP_TARGET, tx_offset + LIN_PIO_TX_WRAP);
+  sm_config_set_sideset(&tx_config, 2, true, false);
+  sm_config_set_out_pins(&tx_config, this->pio_tx_pin_, 1);
+  sm_config_set_sideset_pins(&tx_config, this->pio_tx_pin_);
+  sm_config_set_out_shift(&tx_config, true, false, 32);
+  sm_config_set_fifo_join(&tx_config, PIO_FIFO_JOIN_TX);
+  sm_config_set_clkdiv(&tx_config, clkdiv);
+  pio_sm_init(this->pio_, this->pio_tx_sm_, tx_offset, &tx_config);
+
+  // Every received byte is copied into `pio_rx_ring_` without the CPU.
+  auto rx_dma = dma_channel_get_default_config(this->pio_rx_dma_);
+  channel_config_set_transfer_data_size(&rx_dma, DMA_SIZE_32);
+  channel_config_set_read_increment(&rx_dma, false);
+  channel_config_set_write_increment(&rx_dma, true);
+  static_assert(sizeof(LinBusListener::pio_rx_ring_) == 1 << 7, "DMA ring size");
+  channel_config_set_ring(&rx_dma, true, 7);
+  channel_config_set_dreq(&rx_dma, pio_get_dreq(this->pio_, this->pio_rx_sm_, false));
+  dma_channel_configure(this->pio_rx_dma_, &rx_dma, this->pio_rx_ring_, &this->pio_->rxf[this->pio_rx_sm_],
+                        0xFFFFFFFF, true);
+  this->pio_rx_dma_remaining_ = 0xFFFFFFFF;
+
+  auto tx_dma = dma_channel_get_default_config(this->pio_tx_dma_);
+  channel_config_set_transfer_data_size(&tx_dma, DMA_SIZE_8);
+  channel_config_set_read_increment(&tx_dma, true);
+  channel_config_set_write_increment(&tx_dma, false);
+  channel_config_set_dreq(&tx_dma, pio_get_dreq(this->pio_, this->pio_tx_sm_, true));
+  dma_channel_set_config(this->pio_tx_dma_, &tx_dma, false);
+  dma_channel_set_write_addr(this->pio_tx_dma_, &this->pio_->txf[this->pio_tx_sm_], false);
+
+  // `lin_rx` raises its IRQ once the PID is in the FIFO. It is enabled on core 1 by `onSerialEvent`.
+  this->irq_num_ = this->pio_ == pio0 ? PIO0_IRQ_0 : PIO1_IRQ_0;
+  pio_set_irq0_source_enabled(this->pio_, (pio_interrupt_source) (pis_interrupt0 + this->pio_rx_sm_), true);
+  irq_add_shared_handler(this->irq_num_, LinBusListener::pio_irq_handler_,
+                         PICO_SHARED_IRQ_HANDLER_DEFAULT_ORDER_PRIORITY);
+
+  pio_sm_set_enabled(this->pio_, this->pio_rx_sm_, true);
+  pio_sm_set_enabled(this->pio_, this->pio_tx_sm_, true);
+  return true;
 }
 
-u_int32_t LinBusListener::onSerialEvent() {
-  this->onReceive_();
+void LinBusListener::set_framework_baud_rate_(uint32_t baud_rate) {
+  if (this->pio_ != nullptr) {
+    // Both programs run at 8 cycles per bit.
+    float clkdiv = (float) clock_get_hz(clk_sys) / (8 * baud_rate);
+    pio_sm_set_clkdiv(this->pio_, this->pio_rx_sm_, clkdiv);
+    pio_sm_set_clkdiv(this->pio_, this->pio_tx_sm_, clkdiv);
+  } else if (this->uart_ != nullptr) {
+    uart_set_baudrate(this->uart_, baud_rate);
+  }
+}
 
-  if (this->uart_ != nullptr) {
-    // Receive Status Register/Error Clear Register, UARTRSR/UARTECR
-    // 0x00000004 [2]     : BE (0): Break error
-    auto receive_status_register = uart_get_hw(this->uart_)->rsr;
+void LinBusListener::onSerialEvent() {
+  if (!this->irq_enabled_ && this->irq_num_ != 0) {
+    // The interrupt runs on the core that enables it.
+    irq_set_enabled(this->irq_num_, true);
+    if (this->uart_ != nullptr) {
+      uart_set_irq_enables(this->uart_, true, false);
+    }
+    this->irq_enabled_ = true;
+  }
 
-    if ((receive_status_register & UART_UARTRSR_BE_BITS) == UART_UARTRSR_BE_BITS) {
-      ESP_LOGVV(TAG, "UART%d RX break.", this->uart_number_);
-      // If the break is valid the `onReceive` is called first and the break is handeld. Therfore the expectation is
-      // that the state should be in waiting for `SYNC`.
-      if (this->current_state_ != READ_STATE_BREAK || this->current_state_ != READ_STATE_SYNC) {
-        this->current_state_ = READ_STATE_SYNC;
-      }
+  if (this->frame_timeout_pending_.load()) {
+    this->frame_timeout_pending_.store(false);
+    // The UART interrupt also runs the state machine on this core.
+    auto irq_state = save_and_disable_interrupts();
+    if (this->pio_ != nullptr) {
+      // Response bytes are only in the DMA ring, the PIO IRQ fires at the PID.
+      this->pio_drain_();
+    }
+    this->handle_frame_timeout_(lin_micros());
+    restore_interrupts(irq_state);
+  }
 
-      // Clear Receive Status Register
-      hw_clear_bits(&uart_get_hw(this->uart_)->rsr, UART_UARTRSR_BE_BITS);
+  if (this->answer_timer_pending_.load()) {
+    this->answer_timer_pending_.store(false);
+    auto irq_state = save_and_disable_interrupts();
+    if (this->pio_ != nullptr) {
+      // A response of another node might only be in the DMA ring.
+      this->pio_drain_();
     }
+    this->handle_answer_timer_(lin_micros());
+    restore_interrupts(irq_state);
+  }
+}
+
+void LinBusListener::uart_irq_() {
+  auto start_cycles = arch_get_cpu_cycle_count();
+  auto hw = uart_get_hw(this->uart_);
+  uint32_t bytes = 0;
+
+  if (hw->mis & UART_UARTMIS_TXMIS_BITS) {
+    this->uart_tx_continue_();
   }
 
-  if (this->current_state_ == READ_STATE_BREAK) {
-    // Next is a break. CP Plus has an inter data break of ~35ms
-    auto current = micros();
-    if ((this->last_data_recieved_ + (1000 * 1000 /* 1 second */)) < current) {
-      // I have not recieved data for a while. Sleep deeper
-      return 750;
-    } else if ((this->last_data_recieved_ + (50 * 1000 /* 0.1 second */)) < current) {
-      // I have not recieved data for a while. Sleep deep
-      return 50;
-    } else {
-      // Expecting a SYNC.
-      return 10;
+  while (uart_is_readable(this->uart_)) {
+    // Data register: data byte and the error flags of this byte.
+    auto data_register = hw->dr;
+    if (this->get_lin_bus_fault()) {
+      // Ignore any data present in buffer
+      this->current_state_reset_();
+      continue;
     }
+    // A break is the 0x00 with break error flag.
+    this->read_lin_byte_(data_register & UART_UARTDR_DATA_BITS, data_register & UART_UARTDR_BE_BITS);
+    bytes++;
+  }
+
+  if (bytes > 0) {
+    this->start_frame_timer_();
+    this->rx_cycles_ += arch_get_cpu_cycle_count() - start_cycles;
+    this->rx_bytes_ += bytes;
+    // Wake `loop1()`, a LIN message might be queued.
+    __sev();
+  }
+}
+
+void LinBusListener::pio_drain_() {
+  auto start_cycles = arch_get_cpu_cycle_count();
+  const uint32_t ring_size = LIN_PIO_RX_RING_WORDS;
+  auto channel = &dma_hw->ch[this->pio_rx_dma_];
+  // Transfer count and write address of the same transfer.
+  uint32_t remaining, write_pos;
+  do {
+    remaining = channel->transfer_count;
+    write_pos = (channel->write_addr - (uintptr_t) this->pio_rx_ring_) / sizeof(this->pio_rx_ring_[0]);
+  } while (remaining != channel->transfer_count);
+  // Estimate the arrival of the words from the time of the drain.
+  auto current = lin_micros();
+  uint32_t words = (write_pos + ring_size - this->pio_rx_pos_) % ring_size;
+  uint32_t written = this->pio_rx_dma_remaining_ - remaining;
+  this->pio_rx_dma_remaining_ = remaining;
+  uint32_t bytes = 0;
+
+  if (written >= ring_size) {
+    // The DMA lapped the read position, unread words were overwritten. Skip the ring and wait for the next break.
+    this->pio_rx_ring_stats_.count_read(0, written);
+    this->pio_rx_pos_ = write_pos;
+    words = 0;
+    this->current_state_reset_();
   } else {
-    // Expecting a byte.
-    return 1;
+    this->pio_rx_ring_stats_.count_read(words, 0);
+  }
+
+  for (uint32_t i = 0; i < words; i++) {
+    auto word = this->pio_rx_ring_[this->pio_rx_pos_];
+    this->pio_rx_pos_ = (this->pio_rx_pos_ + 1) % ring_size;
+    if (this->get_lin_bus_fault()) {
+      // Ignore any data present in buffer
+      this->current_state_reset_();
+      continue;
+    }
+    this->read_lin_pio_word_(word, current, words - 1 - i);
+    bytes++;
+  }
+
+  if (remaining < 0x80000000) {
+    // Never let the endless ring transfer run out. A word arriving during the restart is not seen by the lap check.
+    dma_channel_set_trans_count(this->pio_rx_dma_, 0xFFFFFFFF, true);
+    this->pio_rx_dma_remaining_ = channel->transfer_count;
+  }
+
+  if (bytes > 0) {
+    this->start_frame_timer_();
+    this->rx_cycles_ += arch_get_cpu_cycle_count() - start_cycles;
+    this->rx_bytes_ += bytes;
+    // Wake `loop1()`, a LIN message might be queued.
+    __sev();
+  }
+}
+
+void LinBusListener::pio_irq_handler_() {
+  for (size_t i = 0; i < LinBusListener::get_instance_count(); i++) {
+    auto instance = LinBusListener::get_instance(i);
+    if (instance->pio_ != nullptr && pio_interrupt_get(instance->pio_, instance->pio_rx_sm_)) {
+      pio_interrupt_clear(instance->pio_, instance->pio_rx_sm_);
+      instance->pio_drain_();
+    }
+  }
+}
+
+void LinBusListener::uart_tx_start_(const u_int8_t *data, u_int8_t len) {
+  memcpy(this->tx_data_, data, len);
+  this->tx_len_ = len;
+  this->tx_pos_ = 0;
+  if (this->pio_ != nullptr) {
+    // `lin_tx` is fed by DMA.
+    dma_channel_transfer_from_buffer_now(this->pio_tx_dma_, this->tx_data_, len);
+    return;
+  }
+  this->uart_tx_continue_();
+}
+
+void LinBusListener::uart_tx_continue_() {
+  while (this->tx_pos_ < this->tx_len_ && uart_is_writable(this->uart_)) {
+    uart_get_hw(this->uart_)->dr = this->tx_data_[this->tx_pos_++];
+  }
+  // TX interrupt fires when the transmit register is empty again.
+  uart_set_irq_enables(this->uart_, true, this->tx_pos_ < this->tx_len_);
+}
+
+void LinBusListener::uart0_irq_handler_() {
+  for (size_t i = 0; i < LinBusListener::get_instance_count(); i++) {
+    auto instance = LinBusListener::get_instance(i);
+    if (instance->uart_ == uart0) {
+      instance->uart_irq_();
+    }
+  }
+}
+
+void LinBusListener::uart1_irq_handler_() {
+  for (size_t i = 0; i < LinBusListener::get_instance_count(); i++) {
+    auto instance = LinBusListener::get_instance(i);
+    if (instance->uart_ == uart1) {
+      instance->uart_irq_();
+    }
   }
 }
 
@@ -93,27 +335,23 @@ u_int32_t LinBusListener::onSerialEvent() {
 }  // namespace esphome
 
 extern void loop1() {
-  if (LIN_BUS_LISTENER_INSTANCE_1 == nullptr && LIN_BUS_LISTENER_INSTANCE_2 == nullptr) {
+  using esphome::truma_inetbox::LinBusListener;
+  auto count = LinBusListener::get_instance_count();
+  if (count == 0) {
     // Wait for setup_framework to finish.
     delay(100);
   } else {
-    u_int32_t sleep1 = 0xFFFFFFFF;
-    u_int32_t sleep2 = 0xFFFFFFFF;
-    if (LIN_BUS_LISTENER_INSTANCE_1 != nullptr) {
-      sleep1 = LIN_BUS_LISTENER_INSTANCE_1->onSerialEvent();
-    }
-    if (LIN_BUS_LISTENER_INSTANCE_2 != nullptr) {
-      sleep2 = LIN_BUS_LISTENER_INSTANCE_2->onSerialEvent();
+    // One loop serves all LIN buses. Each bus keeps its own state, queues and answers.
+    for (size_t i = 0; i < count; i++) {
+      LinBusListener::get_instance(i)->onSerialEvent();
     }
     // TODO: Reconsider processing lin messages here.
     // They contain blocking log messages.
-    if (LIN_BUS_LISTENER_INSTANCE_1 != nullptr) {
-      LIN_BUS_LISTENER_INSTANCE_1->process_lin_msg_queue(QUEUE_WAIT_DONT_BLOCK);
-    }
-    if (LIN_BUS_LISTENER_INSTANCE_2 != nullptr) {
-      LIN_BUS_LISTENER_INSTANCE_2->process_lin_msg_queue(QUEUE_WAIT_DONT_BLOCK);
+    for (size_t i = 0; i < count; i++) {
+      LinBusListener::get_instance(i)->process_lin_msg_queue(QUEUE_WAIT_DONT_BLOCK);
     }
-    delay(sleep1 > sleep2 ? sleep2 : sleep1);
+    // Sleep until the UART interrupt or the frame timer signals an event.
+    __wfe();
   }
 }
 
@@ -2,73 +2,96 @@
 
 #include "esphome/core/log.h"
 
-#define truma_log(_log_msg_) xQueueSend(this->log_queue_, (void *) &_log_msg_, QUEUE_WAIT_DONT_BLOCK);
+// Log messages of the LIN receive path are pushed to the log queue and written by the main task.
+// The log queue has a single producer: only use these macros in the LIN receive path.
+// Messages pass the runtime filter (`set_log_type_mask`, `set_log_pid_mask`) before they are queued. Check
+// `TRUMA_LOG_ENABLED_ISR` before building the message.
+#define TRUMA_LOG_ENABLED_ISR(_type_, _pid_) this->log_enabled_(_type_, _pid_)
+#define truma_logfromisr(_log_msg_) \
+  do { \
+    if (TRUMA_LOG_ENABLED_ISR(_log_msg_.type, _log_msg_.current_PID)) { \
+      this->log_queue_.push(_log_msg_, lin_micros()); \
+    } \
+  } while (0)
+// Warnings and errors repeated with the same type and PID within `TRUMA_LOG_COALESCE_US` are counted instead of queued.
+#define truma_logfromisr_coalesced(_log_msg_) \
+  do { \
+    if (TRUMA_LOG_ENABLED_ISR(_log_msg_.type, _log_msg_.current_PID)) { \
+      this->log_queue_push_coalesced_(_log_msg_); \
+    } \
+  } while (0)
 
-#define truma_logfromisr(_log_msg_) xQueueSendFromISR(this->log_queue_, (void *) &_log_msg_, QUEUE_WAIT_DONT_BLOCK);
+// Window in microseconds and number of (type, PID) pairs coalesced at once.
+#ifndef  TRUMA_LOG_COALESCE_US
+#define TRUMA_LOG_COALESCE_US 1000000
+#endif
+#ifndef  TRUMA_LOG_COALESCE_SLOTS
+#define TRUMA_LOG_COALESCE_SLOTS 4
+#endif
 
 #if ESPHOME_LOG_LEVEL >= ESPHOME_LOG_LEVEL_VERY_VERBOSE
-#define TRUMA_LOGVV(_log_msg_) truma_log(_log_msg_)
 #define TRUMA_LOGVV_ISR(_log_msg_) truma_logfromisr(_log_msg_)
 #else
-#define TRUMA_LOGVV(_log_msg_)
 #define TRUMA_LOGVV_ISR(_log_msg_)
 #endif
 
 #if ESPHOME_LOG_LEVEL >= ESPHOME_LOG_LEVEL_VERBOSE
-#define TRUMA_LOGV(_log_msg_) truma_log(_log_msg_)
 #define TRUMA_LOGV_ISR(_log_msg_) truma_logfromisr(_log_msg_)
 #else
-#define TRUMA_LOGV(_log_msg_)
 #define TRUMA_LOGV_ISR(_log_msg_)
 #endif
 
 #if ESPHOME_LOG_LEVEL >= ESPHOME_LOG_LEVEL_INFO
-#define TRUMA_LOGI(_log_msg_) truma_log(_log_msg_)
 #define TRUMA_LOGI_ISR(_log_msg_) truma_logfromisr(_log_msg_)
 #else
-#define TRUMA_LOGI(_log_msg_)
 #define TRUMA_LOGI_ISR(_log_msg_)
 #endif
 
 #if ESPHOME_LOG_LEVEL >= ESPHOME_LOG_LEVEL_WARN
-#define TRUMA_LOGW(_log_msg_) truma_log(_log_msg_)
-#define TRUMA_LOGW_ISR(_log_msg_) truma_logfromisr(_log_msg_)
+#define TRUMA_LOGW_ISR(_log_msg_) truma_logfromisr_coalesced(_log_msg_)
 #else
-#define TRUMA_LOGW(_log_msg_)
 #define TRUMA_LOGW_ISR(_log_msg_)
 #endif
 
 #if ESPHOME_LOG_LEVEL >= ESPHOME_LOG_LEVEL_ERROR
-#define TRUMA_LOGE(_log_msg_) truma_log(_log_msg_)
-#define TRUMA_LOGE_ISR(_log_msg_) truma_logfromisr(_log_msg_)
+#define TRUMA_LOGE_ISR(_log_msg_) truma_logfromisr_coalesced(_log_msg_)
 #else
-#define TRUMA_LOGE(_log_msg_)
 #define TRUMA_LOGE_ISR(_log_msg_)
 #endif
 
 enum class QUEUE_LOG_MSG_TYPE {
   UNKNOWN,
-  ERROR_LIN_ANSWER_CAN_WRITE_LIN_ANSWER,
-  ERROR_LIN_ANSWER_TOO_LONG,
   VERBOSE_LIN_ANSWER_RESPONSE,
-  ERROR_CHECK_FOR_LIN_FAULT_DETECTED,
-  INFO_CHECK_FOR_LIN_FAULT_FIXED,
   ERROR_READ_LIN_FRAME_UNABLE_TO_ANSWER,
+  WARN_LIN_ANSWER_COLLISION,
   ERROR_READ_LIN_FRAME_LOST_MSG,
   VV_READ_LIN_FRAME_BREAK_EXPECTED,
   VV_READ_LIN_FRAME_SYNC_EXPECTED,
+  VV_READ_LIN_FRAME_HEADER_TIMEOUT,
   WARN_READ_LIN_FRAME_SID_CRC,
   WARN_READ_LIN_FRAME_LINv1_CRC,
   WARN_READ_LIN_FRAME_LINv2_CRC,
+  INFO_READ_LIN_FRAME_CHECKSUM_MODEL,
   VERBOSE_READ_LIN_FRAME_MSG,
 };
 
+// Bit of `_type_` in the runtime log type mask.
+#define TRUMA_LOG_TYPE_BIT(_type_) (1u << static_cast<uint32_t>(_type_))
+// Types whose `current_PID` is not a PID. Not affected by the PID filter.
+static const uint32_t QUEUE_LOG_MSG_TYPES_WITHOUT_PID =
+    TRUMA_LOG_TYPE_BIT(QUEUE_LOG_MSG_TYPE::VV_READ_LIN_FRAME_BREAK_EXPECTED) |
+    TRUMA_LOG_TYPE_BIT(QUEUE_LOG_MSG_TYPE::VV_READ_LIN_FRAME_SYNC_EXPECTED) |
+    TRUMA_LOG_TYPE_BIT(QUEUE_LOG_MSG_TYPE::VV_READ_LIN_FRAME_HEADER_TIMEOUT);
+
 // Log messages generated during interrupt are pushed to log queue.
 struct QUEUE_LOG_MSG {
   QUEUE_LOG_MSG_TYPE type;
   u_int8_t current_PID;
   u_int8_t data[9];
   u_int8_t len;
+  // Summary of coalesced messages: number of repeats after the logged one and time from it to the last repeat.
+  uint16_t repeats;
+  uint32_t repeat_window;
 #ifdef ESPHOME_LOG_HAS_VERBOSE
   bool current_data_valid;
   bool message_source_know;
@@ -0,0 +1,105 @@
+#ifdef USE_HOST
+#include "LinBusPio.h"
+
+namespace esphome {
+namespace truma_inetbox {
+
+// LIN break: at least 13 dominant bits.
+static const uint8_t LIN_BREAK_BITS = 13;
+
+void LinBusPioModel::step(bool pin) {
+  if (this->delay_ > 0) {
+    this->delay_--;
+    return;
+  }
+  auto instr = LIN_PIO_RX_PROGRAM[this->pc_];
+  uint8_t next = this->pc_ == LIN_PIO_RX_WRAP ? LIN_PIO_RX_WRAP_TARGET : this->pc_ + 1;
+  switch (instr >> 13) {
+    case 0: {
+      // JMP
+      bool jump = false;
+      switch ((instr >> 5) & 0x07) {
+        case 0:
+          jump = true;
+          break;
+        case 2:
+          jump = this->x_-- != 0;
+          break;
+        case 4:
+          jump = this->y_-- != 0;
+          break;
+        case 6:
+          jump = pin;
+          break;
+      }
+      if (jump) {
+        next = instr & 0x1F;
+      }
+      break;
+    }
+    case 1:
+      // WAIT pin: stall without delay until the level matches.
+      if (pin != ((instr & 0x80) != 0)) {
+        return;
+      }
+      break;
+    case 2:
+      // IN pins, 1 (shift right)
+      this->isr_ = (this->isr_ >> 1) | (pin ? 0x80000000 : 0);
+      break;
+    case 4:
+      // PUSH
+      this->rx_fifo.push_back(this->isr_);
+      this->isr_ = 0;
+      break;
+    case 6:
+      // IRQ
+      this->irqs++;
+      break;
+    case 7:
+      // SET
+      if (((instr >> 5) & 0x07) == 1) {
+        this->x_ = instr & 0x1F;
+      } else if (((instr >> 5) & 0x07) == 2) {
+        this->y_ = instr & 0x1F;
+      }
+      break;
+  }
+  this->pc_ = next;
+  this->delay_ = (instr >> 8) & 0x1F;
+}
+
+void LinBusPioModel::feed_bit_(bool level) {
+  for (uint8_t i = 0; i < 8; i++) {
+    this->step(level);
+  }
+}
+
+void LinBusPioModel::feed_idle(uint8_t bits) {
+  for (uint8_t i = 0; i < bits; i++) {
+    this->feed_bit_(true);
+  }
+}
+
+void LinBusPioModel::feed_break() {
+  for (uint8_t i = 0; i < LIN_BREAK_BITS; i++) {
+    this->feed_bit_(false);
+  }
+  // Break delimiter
+  this->feed_bit_(true);
+}
+
+void LinBusPioModel::feed_byte(u_int8_t data) {
+  this->feed_bit_(false);
+  for (uint8_t i = 0; i < 8; i++) {
+    this->feed_bit_((data >> i) & 0x01);
+  }
+  // 2 stop bits
+  this->feed_bit_(true);
+  this->feed_bit_(true);
+}
+
+}  // namespace truma_inetbox
+}  // namespace esphome
+
+#endif  // USE_HOST
@@ -0,0 +1,104 @@
+#pragma once
+
+#include <cstdint>
+#include <sys/types.h>
+#ifdef USE_HOST
+#include <vector>
+#endif  // USE_HOST
+
+namespace esphome {
+namespace truma_inetbox {
+
+// PIO programs of the RP2040 LIN engine. 8 PIO cycles per bit.
+//
+// .program lin_rx
+// .wrap_target
+// start:
+//     wait 0 pin 0        ; Start bit
+//     set x, 7    [10]    ; Middle of the first data bit
+// bitloop:
+//     in pins, 1
+//     jmp x-- bitloop [6]
+//     in pins, 1          ; Stop bit: 0 is a framing error or a break
+//     push
+//     jmp pin good_stop
+//     wait 1 pin 0        ; Break: wait for the line to return to idle
+//     set y, 1            ; Raise the IRQ after SYNC and PID
+//     jmp start
+// good_stop:
+//     jmp y-- start
+//     irq nowait 0 rel    ; PID received
+// .wrap
+static const uint16_t LIN_PIO_RX_PROGRAM[] = {
+    0x2020,  //  0: wait   0 pin, 0
+    0xea27,  //  1: set    x, 7                   [10]
+    0x4001,  //  2: in     pins, 1
+    0x0642,  //  3: jmp    x--, 2                 [6]
+    0x4001,  //  4: in     pins, 1
+    0x8020,  //  5: push   block
+    0x00ca,  //  6: jmp    pin, 10
+    0x20a0,  //  7: wait   1 pin, 0
+    0xe041,  //  8: set    y, 1
+    0x0000,  //  9: jmp    0
+    0x0080,  // 10: jmp    y--, 0
+    0xc010,  // 11: irq    nowait 0 rel
+};
+static const uint8_t LIN_PIO_RX_WRAP_TARGET = 0;
+static const uint8_t LIN_PIO_RX_WRAP = 11;
+
+// .program lin_tx
+// .side_set 1 opt
+// .wrap_target
+//     pull       side 1 [7]  ; Stop bit, or idle while there is no data
+//     set x, 7   side 0 [7]  ; Start bit
+// bitloop:
+//     out pins, 1
+//     jmp x-- bitloop   [6]
+//     nop        side 1 [7]  ; First stop bit
+// .wrap
+static const uint16_t LIN_PIO_TX_PROGRAM[] = {
+    0x9fa0,  //  0: pull   block           side 1 [7]
+    0xf727,  //  1: set    x, 7            side 0 [7]
+    0x6001,  //  2: out    pins, 1
+    0x0642,  //  3: jmp    x--, 2                 [6]
+    0xbf42,  //  4: nop                    side 1 [7]
+};
+static const uint8_t LIN_PIO_TX_WRAP_TARGET = 0;
+static const uint8_t LIN_PIO_TX_WRAP = 4;
+
+// `lin_rx` shifts right: 8 data bits end up in bits 23..30, the stop bit in bit 31.
+inline u_int8_t lin_pio_rx_data(uint32_t word) { return (word >> 23) & 0xFF; }
+// A break is a 0x00 without stop bit. Other framing errors are passed on as data.
+inline bool lin_pio_rx_is_break(uint32_t word) { return (word & 0xFF800000) == 0; }
+// Words of the RP2040 RX DMA ring (128 bytes). Words arriving beyond it between two reads overwrite unread ones.
+static const uint32_t LIN_PIO_RX_RING_WORDS = 32;
+
+#ifdef USE_HOST
+// Executes `lin_rx` on a simulated RX line, one PIO cycle per `step`. Used by the host build instead of the RP2040
+// PIO block, so the decoding of the program can be tested on Linux.
+class LinBusPioModel {
+ public:
+  void step(bool pin);
+  // Line waveforms, 8 cycles per bit.
+  void feed_idle(uint8_t bits);
+  void feed_break();
+  void feed_byte(u_int8_t data);
+
+  // Words pushed to the RX FIFO. The FIFO never fills up.
+  std::vector<uint32_t> rx_fifo;
+  // Number of raised IRQs.
+  uint32_t irqs = 0;
+
+ protected:
+  void feed_bit_(bool level);
+
+  uint8_t pc_ = 0;
+  uint8_t delay_ = 0;
+  uint32_t x_ = 0;
+  uint32_t y_ = 0;
+  uint32_t isr_ = 0;
+};
+#endif  // USE_HOST
+
+}  // namespace truma_inetbox
+}  // namespace esphome
@@ -2,6 +2,7 @@
 #include <array>
 #include "esphome/core/log.h"
 #include "esphome/core/helpers.h"
+#include "helpers.h"
 
 namespace esphome {
 namespace truma_inetbox {
@@ -24,69 +25,84 @@ void LinBusProtocol::lin_reset_device(){
   while (!this->updates_to_send_.empty()) {
     this->updates_to_send_.pop();
   }
+  // An armed response belongs to the old session. Unless it is being sent, the next header is not answered.
+  this->disarm_lin_answer_(DIAGNOSTIC_FRAME_SLAVE);
+  this->updates_to_send_changed_();
 }
 
-bool LinBusProtocol::answer_lin_order_(const u_int8_t pid) {
-  // Send requested answer
-  if (pid == DIAGNOSTIC_FRAME_SLAVE) {
-    if (!this->updates_to_send_.empty()) {
-      auto update_to_send_ = this->updates_to_send_.front();
-      this->updates_to_send_.pop();
-      this->write_lin_answer_(update_to_send_.data(), (u_int8_t) update_to_send_.size());
-      return true;
-    }
+LinBusProtocol::LinBusProtocol() {
+  this->register_lin_provider(DIAGNOSTIC_FRAME_SLAVE, LinBusProtocol::lin_diag_answer_, this,
+                              LinBusProtocol::lin_diag_sent_);
+  this->register_lin_consumer(DIAGNOSTIC_FRAME_MASTER, LinBusProtocol::lin_diag_recieved_, this);
+}
+
+u_int8_t LinBusProtocol::lin_diag_answer_(void *arg, u_int8_t pid, u_int8_t *data) {
+  auto protocol = static_cast<LinBusProtocol *>(arg);
+  // Arm the next diagnostic response once the previous one was sent.
+  if (protocol->updates_to_send_.empty()) {
+    return 0;
   }
-  return false;
+  auto update_to_send_ = protocol->updates_to_send_.front();
+  protocol->updates_to_send_.pop();
+  std::copy(update_to_send_.begin(), update_to_send_.end(), data);
+  return (u_int8_t) update_to_send_.size();
+}
+
+void LinBusProtocol::lin_diag_sent_(void *arg, u_int8_t pid, const u_int8_t *data, u_int8_t length) {
+  static_cast<LinBusProtocol *>(arg)->updates_to_send_changed_();
+}
+
+void LinBusProtocol::lin_diag_recieved_(void *arg, u_int8_t pid, const u_int8_t *message, u_int8_t length) {
+  static_cast<LinBusProtocol *>(arg)->lin_message_recieved_(message, length);
+}
+
+bool LinBusProtocol::has_update_to_send_() {
+  return !this->updates_to_send_.empty() || this->is_lin_answer_armed_(DIAGNOSTIC_FRAME_SLAVE);
 }
 
-void LinBusProtocol::lin_message_recieved_(const u_int8_t pid, const u_int8_t *message, u_int8_t length) {
-  if (pid == DIAGNOSTIC_FRAME_MASTER) {
-    // The original Inet Box is answering this message. Works fine without.
-    // std::array<u_int8_t, 8> message_array = {};
-    // std::copy(message, message + length, message_array.begin());
-    // if (message_array == this->lin_empty_response_) {
-    //   std::array<u_int8_t, 8> response = this->lin_empty_response_;
-    //   response[0] = 0x00;
-    //   response[1] = 0x55;
-    //   response[2] = 0x03;  // this->lin_node_address_;
-    //   response[3] = 0x66;
-    //   response[4] = 0x5B;
-    //   response[5] = 0xA7;
-    //   response[6] = 0x0E;
-    //   response[7] = 0x49;
-    //   this->prepare_update_msg_(response);
-    // }
+void LinBusProtocol::lin_message_recieved_(const u_int8_t *message, u_int8_t length) {
+  // The original Inet Box is answering this message. Works fine without.
+  // std::array<u_int8_t, 8> message_array = {};
+  // std::copy(message, message + length, message_array.begin());
+  // if (message_array == this->lin_empty_response_) {
+  //   std::array<u_int8_t, 8> response = this->lin_empty_response_;
+  //   response[0] = 0x00;
+  //   response[1] = 0x55;
+  //   response[2] = 0x03;  // this->lin_node_address_;
+  //   response[3] = 0x66;
+  //   response[4] = 0x5B;
+  //   response[5] = 0xA7;
+  //   response[6] = 0x0E;
+  //   response[7] = 0x49;
+  //   this->prepare_update_msg_(response);
+  // }
 
+  {
+    // auto node_address = message[0];
+    bool my_node_address = message[0] == this->lin_node_address_;
+    bool broadcast_address = message[0] == LIN_NAD_BROADCAST;
+    if (!my_node_address && !broadcast_address) {
+      return;
+    }
+  }
+  u_int8_t protocol_control_information = message[1];
+  if ((protocol_control_information & 0xF0) == 0x00) {
+    // Single Frame mode
     {
-      // auto node_address = message[0];
-      bool my_node_address = message[0] == this->lin_node_address_;
-      bool broadcast_address = message[0] == LIN_NAD_BROADCAST;
-      if (!my_node_address && !broadcast_address) {
-        return;
-      }
+      // End any open Multi frame mode message
+      this->multi_pdu_message_expected_size_ = 0;
+      this->multi_pdu_message_len_ = 0;
+      this->multi_pdu_message_frame_counter_ = 0;
     }
-    u_int8_t protocol_control_information = message[1];
-    if ((protocol_control_information & 0xF0) == 0x00) {
-      // Single Frame mode
-      {
-        // End any open Multi frame mode message
-        this->multi_pdu_message_expected_size_ = 0;
-        this->multi_pdu_message_len_ = 0;
-        this->multi_pdu_message_frame_counter_ = 0;
-      }
-      this->lin_msg_diag_single_(message, length);
-    } else if ((protocol_control_information & 0xF0) == 0x10) {
-      // First Frame of multi PDU message
-      this->lin_msg_diag_first_(message, length);
-    } else if ((protocol_control_information & 0xF0) == 0x20) {
-      // Consecutive Frames
-      if (this->lin_msg_diag_consecutive_(message, length)) {
-        this->lin_msg_diag_multi_();
-      }
+    this->lin_msg_diag_single_(message, length);
+  } else if ((protocol_control_information & 0xF0) == 0x10) {
+    // First Frame of multi PDU message
+    this->lin_msg_diag_first_(message, length);
+  } else if ((protocol_control_information & 0xF0) == 0x20) {
+    // Consecutive Frames
+    if (this->lin_msg_diag_consecutive_(message, length)) {
+      this->lin_msg_diag_multi_();
     }
-
-  } else if (pid == this->lin_node_address_) {
-    ESP_LOGW(TAG, "Unhandled message for me.");
   }
 }
 
@@ -163,9 +179,11 @@ void LinBusProtocol::lin_msg_diag_single_(const u_int8_t *message, u_int8_t leng
     }
   } else {
     if (my_node_address) {
-      ESP_LOGD(TAG, "SID %02X  MY  - %s - Unhandled", service_identifier, format_hex_pretty(message, length).c_str());
+      ESP_LOGD(TAG, "SID %02X  MY  - %s - Unhandled", service_identifier,
+               format_hex_pretty_fixed(message, length).c_str());
     } else if (broadcast_address) {
-      ESP_LOGD(TAG, "SID %02X  BC  - %s - Unhandled", service_identifier, format_hex_pretty(message, length).c_str());
+      ESP_LOGD(TAG, "SID %02X  BC  - %s - Unhandled", service_identifier,
+               format_hex_pretty_fixed(message, length).c_str());
     }
   }
 }
@@ -223,13 +241,13 @@ bool LinBusProtocol::lin_msg_diag_consecutive_(const u_int8_t *message, u_int8_t
 
 void LinBusProtocol::lin_msg_diag_multi_() {
   ESP_LOGD(TAG, "Multi package request  %s",
-           format_hex_pretty(this->multi_pdu_message_, this->multi_pdu_message_len_).c_str());
+           format_hex_pretty_fixed(this->multi_pdu_message_, this->multi_pdu_message_len_).c_str());
 
   u_int8_t answer_len = 0;
   // Ask handling class what to answer to this request.
   auto answer = this->lin_multiframe_recieved(this->multi_pdu_message_, this->multi_pdu_message_len_, &answer_len);
   if (answer_len > 0) {
-    ESP_LOGD(TAG, "Multi package response %s", format_hex_pretty(answer, answer_len).c_str());
+    ESP_LOGD(TAG, "Multi package response %s", format_hex_pretty_fixed(answer, answer_len).c_str());
 
     std::array<u_int8_t, 8> response = this->lin_empty_response_;
     if (answer_len <= 6) {
@@ -7,6 +7,7 @@ namespace esphome {
 namespace truma_inetbox {
 class LinBusProtocol : public LinBusListener {
  public:
+  LinBusProtocol();
   virtual const std::array<u_int8_t, 4> lin_identifier() = 0;
   virtual void lin_heartbeat() = 0;
   virtual void lin_reset_device();
@@ -14,19 +15,29 @@ class LinBusProtocol : public LinBusListener {
  protected:
   const std::array<u_int8_t, 8> lin_empty_response_ = {0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF};
 
-  bool answer_lin_order_(const u_int8_t pid) override;
-  void lin_message_recieved_(const u_int8_t pid, const u_int8_t *message, u_int8_t length) override;
-
   virtual bool lin_read_field_by_identifier_(u_int8_t identifier, std::array<u_int8_t, 5> *response) = 0;
   virtual const u_int8_t *lin_multiframe_recieved(const u_int8_t *message, const u_int8_t message_len,
                                                   u_int8_t *return_len) = 0;
 
   std::queue<std::array<u_int8_t, 8>> updates_to_send_ = {};
+  // A diagnostic response is queued or armed.
+  bool has_update_to_send_();
+  // Called in the LIN message task when a diagnostic response was queued, sent or dropped.
+  virtual void updates_to_send_changed_() {}
 
  private:
   u_int8_t lin_node_address_ = /*LIN initial node address*/ 0x03;
 
-  void prepare_update_msg_(const std::array<u_int8_t, 8> message) { this->updates_to_send_.push(std::move(message)); }
+  // Provider of `DIAGNOSTIC_FRAME_SLAVE` and consumer of `DIAGNOSTIC_FRAME_MASTER`.
+  static u_int8_t lin_diag_answer_(void *arg, u_int8_t pid, u_int8_t *data);
+  static void lin_diag_sent_(void *arg, u_int8_t pid, const u_int8_t *data, u_int8_t length);
+  static void lin_diag_recieved_(void *arg, u_int8_t pid, const u_int8_t *message, u_int8_t length);
+  void lin_message_recieved_(const u_int8_t *message, u_int8_t length);
+
+  void prepare_update_msg_(const std::array<u_int8_t, 8> message) {
+    this->updates_to_send_.push(std::move(message));
+    this->updates_to_send_changed_();
+  }
   bool is_matching_identifier_(const u_int8_t *message);
 
   u_int16_t multi_pdu_message_expected_size_ = 0;
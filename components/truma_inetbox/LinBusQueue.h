@@ -0,0 +1,98 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+namespace esphome {
+namespace truma_inetbox {
+
+// Telemetry of a `LinBusQueue`. Producer counters are only written by the producer, consumer counters by the consumer.
+class LinBusQueueStats {
+ public:
+  // Items accepted by the queue.
+  uint32_t get_enqueued() const { return this->enqueued_; }
+  // Items lost because the queue was full.
+  uint32_t get_dropped() const { return this->dropped_; }
+  // Highest number of items waiting in the queue.
+  uint32_t get_high_water() const { return this->high_water_; }
+  // Longest time in microseconds an item waited for the consumer.
+  uint32_t get_latency_max() const { return this->latency_max_; }
+  // Same as `get_latency_max`, but restarts the measurement. A concurrent pop can lose one sample.
+  uint32_t take_latency_max() {
+    auto latency_max = this->latency_max_;
+    this->latency_max_ = 0;
+    return latency_max;
+  }
+  // Count a read of a buffer filled by hardware (RP2040 DMA ring): `items` read at once, `dropped` overwritten before.
+  void count_read(uint32_t items, uint32_t dropped) {
+    this->enqueued_ += items;
+    this->dropped_ += dropped;
+    if (items > this->high_water_) {
+      this->high_water_ = items;
+    }
+  }
+
+ protected:
+  uint32_t enqueued_ = 0;
+  uint32_t dropped_ = 0;
+  uint32_t high_water_ = 0;
+  uint32_t latency_max_ = 0;
+};
+
+// Lock-free single producer / single consumer ring buffer.
+// `push` is wait-free and only called by the producer (LIN receive path), `pop` only by the consumer.
+template<typename T, size_t N> class LinBusQueue : public LinBusQueueStats {
+  static_assert(N > 0 && (N & (N - 1)) == 0, "Queue length must be a power of two.");
+
+ public:
+  // Returns false and counts the item as dropped if the queue is full. `now` is the current time in microseconds.
+  bool push(const T &item, uint32_t now) {
+    auto head = this->head_.load(std::memory_order_relaxed);
+    auto level = head - this->tail_.load(std::memory_order_acquire);
+    if (level >= N) {
+      this->dropped_++;
+      return false;
+    }
+    this->items_[head % N] = item;
+    this->pushed_at_[head % N] = now;
+    this->head_.store(head + 1, std::memory_order_release);
+    this->enqueued_++;
+    if (level + 1 > this->high_water_) {
+      this->high_water_ = level + 1;
+    }
+    return true;
+  }
+
+  // Copy up to `max_count` items into `items`. Returns the number of items copied.
+  size_t pop(T *items, size_t max_count, uint32_t now) {
+    auto tail = this->tail_.load(std::memory_order_relaxed);
+    size_t count = this->head_.load(std::memory_order_acquire) - tail;
+    if (count > max_count) {
+      count = max_count;
+    }
+    for (size_t i = 0; i < count; i++) {
+      items[i] = this->items_[(tail + i) % N];
+      auto latency = now - this->pushed_at_[(tail + i) % N];
+      if (latency > this->latency_max_) {
+        this->latency_max_ = latency;
+      }
+    }
+    this->tail_.store(tail + count, std::memory_order_release);
+    return count;
+  }
+
+  bool empty() const {
+    return this->head_.load(std::memory_order_acquire) == this->tail_.load(std::memory_order_acquire);
+  }
+  static constexpr size_t capacity() { return N; }
+
+ protected:
+  std::atomic<uint32_t> head_{0};
+  std::atomic<uint32_t> tail_{0};
+  T items_[N];
+  uint32_t pushed_at_[N];
+};
+
+}  // namespace truma_inetbox
+}  // namespace esphome
@@ -0,0 +1,102 @@
+#include "LinBusTimer.h"
+#include "esphome/core/log.h"
+#ifdef USE_HOST
+#include <vector>
+#endif  // USE_HOST
+
+namespace esphome {
+namespace truma_inetbox {
+
+static const char *const TAG = "truma_inetbox.LinBusTimer";
+
+#ifdef USE_ESP32
+void LinBusTimer::setup(callback_t callback, void *arg, const char *name) {
+  this->callback_ = callback;
+  this->arg_ = arg;
+  esp_timer_create_args_t args = {};
+  args.callback = callback;
+  args.arg = arg;
+  args.dispatch_method = ESP_TIMER_TASK;
+  args.name = name;
+  if (esp_timer_create(&args, &this->handle_) != ESP_OK) {
+    ESP_LOGE(TAG, "Unable to create LIN timer '%s'.", name);
+    this->handle_ = nullptr;
+  }
+}
+
+void LinBusTimer::start_at(uint32_t deadline) {
+  if (this->handle_ == nullptr) {
+    return;
+  }
+  int32_t timeout = deadline - lin_micros();
+  // Fails if the timer is not running.
+  esp_timer_stop(this->handle_);
+  esp_timer_start_once(this->handle_, timeout > 0 ? timeout : 0);
+}
+#endif  // USE_ESP32
+
+#ifdef USE_RP2040
+void LinBusTimer::setup(callback_t callback, void *arg, const char *name) {
+  this->callback_ = callback;
+  this->arg_ = arg;
+}
+
+void LinBusTimer::start_at(uint32_t deadline) {
+  if (this->alarm_ > 0) {
+    cancel_alarm(this->alarm_);
+  }
+  int32_t timeout = deadline - lin_micros();
+  this->alarm_ = add_alarm_in_us(timeout > 0 ? timeout : 0, LinBusTimer::alarm_callback_, this, true);
+}
+
+int64_t LinBusTimer::alarm_callback_(alarm_id_t id, void *user_data) {
+  auto timer = (LinBusTimer *) user_data;
+  timer->callback_(timer->arg_);
+  // Do not reschedule.
+  return 0;
+}
+#endif  // USE_RP2040
+
+#ifdef USE_HOST
+static uint64_t lin_virtual_micros = 0;
+static std::vector<LinBusTimer *> lin_virtual_timers;
+
+uint64_t lin_micros64() { return lin_virtual_micros; }
+
+void lin_micros_advance(uint32_t us) {
+  uint64_t target = lin_virtual_micros + us;
+  for (;;) {
+    // Fire due timers in deadline order, with the clock set to their deadline.
+    LinBusTimer *next = nullptr;
+    for (auto timer : lin_virtual_timers) {
+      if (timer->active_ && lin_time_reached((uint32_t) target, timer->deadline_) &&
+          (next == nullptr || lin_time_reached(next->deadline_, timer->deadline_))) {
+        next = timer;
+      }
+    }
+    if (next == nullptr) {
+      break;
+    }
+    if (lin_time_reached(next->deadline_, lin_micros())) {
+      lin_virtual_micros += (uint32_t) (next->deadline_ - lin_micros());
+    }
+    next->active_ = false;
+    next->callback_(next->arg_);
+  }
+  lin_virtual_micros = target;
+}
+
+void LinBusTimer::setup(callback_t callback, void *arg, const char *name) {
+  this->callback_ = callback;
+  this->arg_ = arg;
+  lin_virtual_timers.push_back(this);
+}
+
+void LinBusTimer::start_at(uint32_t deadline) {
+  this->deadline_ = deadline;
+  this->active_ = true;
+}
+#endif  // USE_HOST
+
+}  // namespace truma_inetbox
+}  // namespace esphome
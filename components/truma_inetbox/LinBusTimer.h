@@ -0,0 +1,45 @@
+#pragma once
+
+#include <cstdint>
+#include "LinBusClock.h"
+
+#ifdef USE_ESP32
+#include <esp_timer.h>
+#endif  // USE_ESP32
+#ifdef USE_RP2040
+#include <pico/time.h>
+#endif  // USE_RP2040
+
+namespace esphome {
+namespace truma_inetbox {
+
+// One-shot timer firing at a `lin_micros()` time, independent of UART traffic.
+// ESP32: `esp_timer` (esp_timer task or interrupt), RP2040: SDK alarm (interrupt), host: fired by `lin_micros_advance`.
+class LinBusTimer {
+ public:
+  typedef void (*callback_t)(void *arg);
+
+  // `name` of the ESP32 `esp_timer`. The ESP32 callback runs in the esp_timer task.
+  void setup(callback_t callback, void *arg, const char *name = "lin_frame");
+  // Restart the timer. `deadline` must be less than 2^31 us away.
+  void start_at(uint32_t deadline);
+
+ protected:
+  callback_t callback_ = nullptr;
+  void *arg_ = nullptr;
+#ifdef USE_ESP32
+  esp_timer_handle_t handle_ = nullptr;
+#endif  // USE_ESP32
+#ifdef USE_RP2040
+  alarm_id_t alarm_ = 0;
+  static int64_t alarm_callback_(alarm_id_t id, void *user_data);
+#endif  // USE_RP2040
+#ifdef USE_HOST
+  bool active_ = false;
+  uint32_t deadline_ = 0;
+  friend void lin_micros_advance(uint32_t us);
+#endif  // USE_HOST
+};
+
+}  // namespace truma_inetbox
+}  // namespace esphome
@@ -0,0 +1,84 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <sys/types.h>
+
+namespace esphome {
+namespace truma_inetbox {
+
+// Timing of the frame being received. Times are `lin_micros()` of the byte, estimated per byte within a chunk.
+struct LinFrame {
+  // 0x00 of the break. Not set if the backend does not relay the break.
+  uint32_t break_at = 0;
+  bool has_break = false;
+  uint32_t sync_at = 0;
+  // `sync_at` is not estimated from a chunk.
+  bool sync_exact = false;
+  uint32_t pid_at = 0;
+  // First byte of the response.
+  uint32_t response_at = 0;
+  uint32_t last_byte_at = 0;
+  // Longest gap between two response bytes.
+  uint32_t max_gap = 0;
+  u_int8_t pid = 0;
+  // Response bytes including checksum.
+  u_int8_t len = 0;
+};
+
+// Histogram of durations in microseconds with `LIN_HISTOGRAM_BUCKETS` buckets of `LIN_HISTOGRAM_BUCKET_US` (or the
+// width given to the constructor) and one overflow bucket. Written by the LIN receive path, read by sensors. A concurrent read can miss the latest sample.
+static const size_t LIN_HISTOGRAM_BUCKETS = 32;
+static const uint32_t LIN_HISTOGRAM_BUCKET_US = 250;
+
+class LinBusHistogram {
+ public:
+  explicit LinBusHistogram(uint32_t bucket_us = LIN_HISTOGRAM_BUCKET_US) : bucket_us_(bucket_us) {}
+
+  void add(uint32_t us) {
+    auto bucket = us / this->bucket_us_;
+    this->buckets_[bucket < LIN_HISTOGRAM_BUCKETS ? bucket : LIN_HISTOGRAM_BUCKETS]++;
+    this->count_++;
+    if (us > this->max_) {
+      this->max_ = us;
+    }
+    if (us > this->max_ever_) {
+      this->max_ever_ = us;
+    }
+  }
+
+  uint32_t get_count() const { return this->count_; }
+  // Longest duration since the last `take_max`.
+  uint32_t take_max() {
+    auto max = this->max_;
+    this->max_ = 0;
+    return max;
+  }
+  // Upper bound of the bucket holding the `percent` percentile. Returns 0 without samples and the longest duration
+  // ever seen if the percentile is in the overflow bucket.
+  uint32_t get_percentile(u_int8_t percent) const {
+    uint32_t count = this->count_;
+    if (count == 0) {
+      return 0;
+    }
+    uint64_t target = ((uint64_t) count * percent + 99) / 100;
+    uint32_t seen = 0;
+    for (size_t i = 0; i < LIN_HISTOGRAM_BUCKETS; i++) {
+      seen += this->buckets_[i];
+      if (seen >= target) {
+        return (i + 1) * this->bucket_us_;
+      }
+    }
+    return this->max_ever_;
+  }
+
+ protected:
+  const uint32_t bucket_us_;
+  uint32_t buckets_[LIN_HISTOGRAM_BUCKETS + 1] = {};
+  uint32_t count_ = 0;
+  uint32_t max_ = 0;
+  uint32_t max_ever_ = 0;
+};
+
+}  // namespace truma_inetbox
+}  // namespace esphome
@@ -0,0 +1,89 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <sys/types.h>
+
+// Records in the LIN trace ring, must be a power of two. 16 bytes each.
+#ifndef  TRUMA_TRACE_LENGTH
+#define TRUMA_TRACE_LENGTH 128
+#endif
+
+namespace esphome {
+namespace truma_inetbox {
+
+// `LinTraceRecord::flags`
+static const u_int8_t LIN_TRACE_CHECKSUM_VALID = 0x01;
+static const u_int8_t LIN_TRACE_SOURCE_KNOWN = 0x02;
+static const u_int8_t LIN_TRACE_FROM_MASTER = 0x04;
+static const u_int8_t LIN_TRACE_OWN_ANSWER = 0x08;
+static const u_int8_t LIN_TRACE_COLLISION = 0x10;
+// Frame ended before its expected length (lost or partial response, unable to answer).
+static const u_int8_t LIN_TRACE_INCOMPLETE = 0x20;
+static const u_int8_t LIN_TRACE_SID_PARITY_ERROR = 0x40;
+static const u_int8_t LIN_TRACE_HARDWARE_BREAK = 0x80;
+
+// One LIN frame as stored in the trace ring and dumped as hex. Little endian, no padding.
+struct LinTraceRecord {
+  // `lin_micros()` of the PID.
+  uint32_t timestamp;
+  // PID with parity bits.
+  u_int8_t pid;
+  u_int8_t flags;
+  // Response bytes in `data`, the last one is the checksum of a complete frame.
+  u_int8_t len;
+  u_int8_t data[9];
+};
+static_assert(sizeof(LinTraceRecord) == 16, "LinTraceRecord is dumped as 16 bytes.");
+
+// Ring of the last `TRUMA_TRACE_LENGTH` frames. Written by the LIN receive path only, read by the main loop without
+// stopping the writer: records overwritten while they were copied are dropped.
+class LinBusTrace {
+ public:
+  void add(const LinTraceRecord &record) {
+    auto written = this->written_.load(std::memory_order_relaxed);
+    this->records_[written & (TRUMA_TRACE_LENGTH - 1)] = record;
+    this->written_.store(written + 1, std::memory_order_release);
+  }
+
+  // Records written since boot. The sequence number of the next record.
+  uint32_t get_written() const { return this->written_.load(std::memory_order_acquire); }
+
+  // Copy up to `max` records starting at sequence number `*seq` and advance `*seq` past them. Records no longer in the
+  // ring are skipped. Returns the number of copied records.
+  size_t read(uint32_t *seq, LinTraceRecord *out, size_t max) const {
+    auto written = this->get_written();
+    if (written - *seq > TRUMA_TRACE_LENGTH - 1) {
+      *seq = written - (TRUMA_TRACE_LENGTH - 1);
+    }
+    size_t count = written - *seq;
+    if (count > max) {
+      count = max;
+    }
+    for (size_t i = 0; i < count; i++) {
+      out[i] = this->records_[(*seq + i) & (TRUMA_TRACE_LENGTH - 1)];
+    }
+    // A record is intact if its slot was not reused while copying. The slot of `seq` is written again as record
+    // `seq + TRUMA_TRACE_LENGTH`, which starts once `written_` reached that value minus one.
+    auto after = this->get_written();
+    size_t torn = 0;
+    if (after - *seq > TRUMA_TRACE_LENGTH - 1) {
+      torn = after - *seq - (TRUMA_TRACE_LENGTH - 1);
+      if (torn > count) {
+        torn = count;
+      }
+      memmove(out, out + torn, (count - torn) * sizeof(LinTraceRecord));
+    }
+    *seq += count;
+    return count - torn;
+  }
+
+ protected:
+  LinTraceRecord records_[TRUMA_TRACE_LENGTH];
+  std::atomic<uint32_t> written_{0};
+};
+
+}  // namespace truma_inetbox
+}  // namespace esphome
@@ -16,9 +16,24 @@ TrumaiNetBoxApp::TrumaiNetBoxApp() {
   // this->config_.set_parent(this);
   this->heater_.set_parent(this);
   this->timer_.set_parent(this);
+  this->register_lin_provider(LIN_PID_TRUMA_INET_BOX, TrumaiNetBoxApp::lin_alive_answer_, this,
+                              TrumaiNetBoxApp::lin_alive_sent_);
+}
+
+void TrumaiNetBoxApp::loop() {
+  // Updates are submitted by actions in the main loop. Announce them with the next alive answer, not the one after.
+  bool has_update = this->airconAuto_.has_update() || this->airconManual_.has_update() || this->clock_.has_update() ||
+                    this->heater_.has_update() || this->timer_.has_update();
+  if (has_update != this->alive_has_update_) {
+    this->alive_has_update_ = has_update;
+    this->refresh_lin_answer(LIN_PID_TRUMA_INET_BOX);
+  }
 }
 
 void TrumaiNetBoxApp::update() {
+  // The 5 second repeats of `has_update_to_submit_` depend on the time only.
+  this->refresh_lin_answer(LIN_PID_TRUMA_INET_BOX);
+
   // Call listeners in after method 'lin_multiframe_recieved' call.
   // Because 'lin_multiframe_recieved' is time critical an all these sensors can take some time.
 
@@ -38,7 +53,7 @@ void TrumaiNetBoxApp::update() {
   // - Update was not done
   // - 30 seconds after init data recieved
   if (this->time_ != nullptr && !this->update_status_clock_done && this->init_recieved_ > 0) {
-    if (micros() > ((30 * 1000 * 1000) + this->init_recieved_ /* 30 seconds after init recieved */)) {
+    if (lin_micros64() - this->init_recieved_ > 30 * 1000 * 1000 /* 30 seconds after init recieved */) {
       this->update_status_clock_done = true;
       this->clock_.action_write_time();
     }
@@ -68,11 +83,11 @@ const std::array<uint8_t, 4> TrumaiNetBoxApp::lin_identifier() {
   return {0x17 /*Supplied Id*/, 0x46 /*Supplied Id*/, 0x00 /*Function Id*/, 0x1F /*Function Id*/};
 }
 
-void TrumaiNetBoxApp::lin_heartbeat() { this->device_registered_ = micros(); }
+void TrumaiNetBoxApp::lin_heartbeat() { this->device_registered_ = lin_micros64(); }
 
 void TrumaiNetBoxApp::lin_reset_device() {
   LinBusProtocol::lin_reset_device();
-  this->device_registered_ = micros();
+  this->device_registered_ = lin_micros64();
   this->init_recieved_ = 0;
 
   this->airconAuto_.reset();
@@ -85,18 +100,29 @@ void TrumaiNetBoxApp::lin_reset_device() {
   this->update_time_ = 0;
 }
 
-bool TrumaiNetBoxApp::answer_lin_order_(const u_int8_t pid) {
+u_int8_t TrumaiNetBoxApp::lin_alive_answer_(void *arg, u_int8_t pid, u_int8_t *data) {
+  auto app = static_cast<TrumaiNetBoxApp *>(arg);
   // Alive message
-  if (pid == LIN_PID_TRUMA_INET_BOX) {
-    std::array<u_int8_t, 8> response = this->lin_empty_response_;
+  std::array<u_int8_t, 8> response = app->lin_empty_response_;
 
-    if (this->updates_to_send_.empty() && !this->has_update_to_submit_()) {
-      response[0] = 0xFE;
-    }
-    this->write_lin_answer_(response.data(), (u_int8_t) sizeof(response));
-    return true;
+  if (!app->has_update_to_send_() && !app->has_update_to_submit_()) {
+    response[0] = 0xFE;
+  }
+  std::copy(response.begin(), response.end(), data);
+  return (u_int8_t) response.size();
+}
+
+void TrumaiNetBoxApp::lin_alive_sent_(void *arg, u_int8_t pid, const u_int8_t *data, u_int8_t length) {
+  auto app = static_cast<TrumaiNetBoxApp *>(arg);
+  // The CP Plus was asked to read. Repeat in 5 seconds unless it does.
+  if (data[0] == 0xFE || !app->has_update_to_submit_()) {
+    return;
+  }
+  if (app->init_recieved_ == 0) {
+    app->init_requested_ = lin_micros64();
+  } else {
+    app->update_time_ = lin_micros64();
   }
-  return LinBusProtocol::answer_lin_order_(pid);
 }
 
 bool TrumaiNetBoxApp::lin_read_field_by_identifier_(u_int8_t identifier, std::array<u_int8_t, 5> *response) {
@@ -127,7 +153,7 @@ bool TrumaiNetBoxApp::lin_read_field_by_identifier_(u_int8_t identifier, std::ar
 
 const u_int8_t *TrumaiNetBoxApp::lin_multiframe_recieved(const u_int8_t *message, const u_int8_t message_len,
                                                          u_int8_t *return_len) {
-  static u_int8_t response[48] = {};
+  auto response = this->multiframe_response_;
   // Validate message prefix.
   if (message_len < truma_message_header.size()) {
     return nullptr;
@@ -144,7 +170,7 @@ const u_int8_t *TrumaiNetBoxApp::lin_multiframe_recieved(const u_int8_t *message
 
   if (message[0] == LIN_SID_READ_STATE_BUFFER) {
     // Example: BA.00.1F.00.1E.00.00.22.FF.FF.FF (11)
-    memset(response, 0, sizeof(response));
+    memset(response, 0, sizeof(this->multiframe_response_));
     auto response_frame = reinterpret_cast<StatusFrame *>(response);
 
     // The order must match with the method 'has_update_to_submit_'.
@@ -354,11 +380,11 @@ const u_int8_t *TrumaiNetBoxApp::lin_multiframe_recieved(const u_int8_t *message
 
     if (device.device_count == 2 && this->heater_device_ != TRUMA_DEVICE::UNKNOWN) {
       // Assumption 2 devices mean CP Plus and Heater.
-      this->init_recieved_ = micros();
+      this->init_recieved_ = lin_micros64();
     } else if (device.device_count == 3 && this->heater_device_ != TRUMA_DEVICE::UNKNOWN &&
                this->aircon_device_ != TRUMA_DEVICE::UNKNOWN) {
       // Assumption 3 devices mean CP Plus, Heater and Aircon.
-      this->init_recieved_ = micros();
+      this->init_recieved_ = lin_micros64();
     }
 
     return response;
@@ -370,32 +396,27 @@ const u_int8_t *TrumaiNetBoxApp::lin_multiframe_recieved(const u_int8_t *message
 }
 
 bool TrumaiNetBoxApp::has_update_to_submit_() {
-  // No logging in this message!
-  // It is called by interrupt. Logging is a blocking operation (especially when Wifi Logging).
-  // If logging is necessary use logging queue of LinBusListener class.
+  // Called when the alive message answer is armed or refreshed, without side effects. `lin_alive_sent_` records when
+  // the CP Plus was asked.
   if (this->init_requested_ == 0) {
-    this->init_requested_ = micros();
     // ESP_LOGD(TAG, "Requesting initial data.");
     return true;
   } else if (this->init_recieved_ == 0) {
-    auto init_wait_time = micros() - this->init_requested_;
+    auto init_wait_time = lin_micros64() - this->init_requested_;
     // it has been 5 seconds and i am still awaiting the init data.
     if (init_wait_time > 1000 * 1000 * 5) {
       // ESP_LOGD(TAG, "Requesting initial data again.");
-      this->init_requested_ = micros();
       return true;
     }
   } else if (this->airconAuto_.has_update() || this->airconManual_.has_update() || this->clock_.has_update() ||
              this->heater_.has_update() || this->timer_.has_update()) {
     if (this->update_time_ == 0) {
       // ESP_LOGD(TAG, "Notify CP Plus I got updates.");
-      this->update_time_ = micros();
       return true;
     }
-    auto update_wait_time = micros() - this->update_time_;
+    auto update_wait_time = lin_micros64() - this->update_time_;
     if (update_wait_time > 1000 * 1000 * 5) {
       // ESP_LOGD(TAG, "Notify CP Plus again I still got updates.");
-      this->update_time_ = micros();
       return true;
     }
   }
@@ -21,6 +21,7 @@ namespace truma_inetbox {
 class TrumaiNetBoxApp : public LinBusProtocol {
  public:
   TrumaiNetBoxApp();
+  void loop() override;
   void update() override;
 
   const std::array<u_int8_t, 4> lin_identifier() override;
@@ -37,7 +38,8 @@ class TrumaiNetBoxApp : public LinBusProtocol {
   TrumaiNetBoxAppHeater *get_heater() { return &this->heater_; }
   TrumaiNetBoxAppTimer *get_timer() { return &this->timer_; }
 
-  int64_t get_last_cp_plus_request() { return this->device_registered_; }
+  // `lin_micros64()` of the last heartbeat of the CP Plus, `0` before the first.
+  uint64_t get_last_cp_plus_request() { return this->device_registered_; }
 
 #ifdef USE_TIME
   void set_time(time::RealTimeClock *time) { time_ = time; }
@@ -46,9 +48,10 @@ class TrumaiNetBoxApp : public LinBusProtocol {
 
  protected:
   // Truma CP Plus needs init (reset). This device is not registered.
-  uint32_t device_registered_ = 0;
-  uint32_t init_requested_ = 0;
-  uint32_t init_recieved_ = 0;
+  // Times are `lin_micros64()`, they outlive the wraparound of `lin_micros()`.
+  uint64_t device_registered_ = 0;
+  uint64_t init_requested_ = 0;
+  uint64_t init_recieved_ = 0;
   u_int8_t message_counter = 1;
 
   // Truma heater conected to CP Plus.
@@ -64,7 +67,10 @@ class TrumaiNetBoxApp : public LinBusProtocol {
   TrumaiNetBoxAppTimer timer_;
 
   // last time CP plus was informed I got an update msg.
-  uint32_t update_time_ = 0;
+  uint64_t update_time_ = 0;
+
+  // Answer of `lin_multiframe_recieved`. Owned by this LIN bus.
+  u_int8_t multiframe_response_[48] = {};
 
 #ifdef USE_TIME
   time::RealTimeClock *time_ = nullptr;
@@ -73,7 +79,12 @@ class TrumaiNetBoxApp : public LinBusProtocol {
   bool update_status_clock_done = false;
 #endif  // USE_TIME
 
-  bool answer_lin_order_(const u_int8_t pid) override;
+  // Provider of `LIN_PID_TRUMA_INET_BOX`.
+  static u_int8_t lin_alive_answer_(void *arg, u_int8_t pid, u_int8_t *data);
+  static void lin_alive_sent_(void *arg, u_int8_t pid, const u_int8_t *data, u_int8_t length);
+  // Any component has an update, as last seen by `loop()`.
+  bool alive_has_update_ = false;
+  void updates_to_send_changed_() override { this->refresh_lin_answer(LIN_PID_TRUMA_INET_BOX); }
 
   bool lin_read_field_by_identifier_(u_int8_t identifier, std::array<u_int8_t, 5> *response) override;
   const u_int8_t *lin_multiframe_recieved(const u_int8_t *message, const u_int8_t message_len,
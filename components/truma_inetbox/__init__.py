@@ -19,6 +19,10 @@ from esphome.const import (
     CONF_STOP,
     CONF_TIME_ID,
     CONF_TIME,
+    CONF_LENGTH,
+    CONF_DEBUG,
+    KEY_CORE,
+    KEY_FRAMEWORK_VERSION,
 )
 from esphome.components.uart import (
     CONF_STOP_BITS,
@@ -30,6 +34,7 @@ from esphome.core import CORE
 from .entity_helpers import count_id_usage
 
 DEPENDENCIES = ["uart"]
+MULTI_CONF = True
 CODEOWNERS = ["@Fabian-Schmidt"]
 
 CONF_TRUMA_INETBOX_ID = "truma_inetbox_id"
@@ -38,6 +43,17 @@ CONF_FAULT_PIN = "fault_pin"
 CONF_OBSERVER_MODE = "observer_mode"
 CONF_NUMBER_OF_CHILDREN = "number_of_children"
 CONF_ON_HEATER_MESSAGE = "on_heater_message"
+CONF_ON_LIN_FRAME = "on_lin_frame"
+CONF_LIN_DATA_LENGTHS = "lin_data_lengths"
+CONF_HARDWARE_BREAK = "hardware_break"
+CONF_UART_ISR = "uart_isr"
+CONF_PIO = "pio"
+CONF_BAUD_RATE_TRACKING = "baud_rate_tracking"
+CONF_RESPONSE_DELAY = "response_delay"
+CONF_PID = "pid"
+CONF_LOG_TYPES = "log_types"
+CONF_LOG_PIDS = "log_pids"
+CONF_TYPES = "types"
 
 truma_inetbox_ns = cg.esphome_ns.namespace("truma_inetbox")
 StatusFrameHeater = truma_inetbox_ns.struct("StatusFrameHeater")
@@ -49,6 +65,11 @@ TrumaiNetBoxAppHeaterMessageTrigger = truma_inetbox_ns.class_(
     "TrumaiNetBoxAppHeaterMessageTrigger",
     automation.Trigger.template(StatusFrameHeaterConstPtr),
 )
+QueueLinFrameConstPtr = truma_inetbox_ns.struct("QUEUE_LIN_FRAME").operator("ptr").operator("const")
+TrumaiNetBoxAppLinFrameTrigger = truma_inetbox_ns.class_(
+    "TrumaiNetBoxAppLinFrameTrigger",
+    automation.Trigger.template(QueueLinFrameConstPtr),
+)
 
 # `LIN_CHECKSUM` is a enum class and not a namespace but it works.
 LIN_CHECKSUM_dummy_ns = truma_inetbox_ns.namespace("LIN_CHECKSUM")
@@ -58,6 +79,24 @@ CONF_SUPPORTED_LIN_CHECKSUM = {
     "VERSION_2": LIN_CHECKSUM_dummy_ns.LIN_CHECKSUM_VERSION_2,
 }
 
+# `QUEUE_LOG_MSG_TYPE` is a enum class and not a namespace but it works.
+QUEUE_LOG_MSG_TYPE_dummy_ns = cg.global_ns.namespace("QUEUE_LOG_MSG_TYPE")
+
+CONF_SUPPORTED_LOG_TYPE = {
+    "VERBOSE_LIN_ANSWER_RESPONSE": QUEUE_LOG_MSG_TYPE_dummy_ns.VERBOSE_LIN_ANSWER_RESPONSE,
+    "ERROR_READ_LIN_FRAME_UNABLE_TO_ANSWER": QUEUE_LOG_MSG_TYPE_dummy_ns.ERROR_READ_LIN_FRAME_UNABLE_TO_ANSWER,
+    "WARN_LIN_ANSWER_COLLISION": QUEUE_LOG_MSG_TYPE_dummy_ns.WARN_LIN_ANSWER_COLLISION,
+    "ERROR_READ_LIN_FRAME_LOST_MSG": QUEUE_LOG_MSG_TYPE_dummy_ns.ERROR_READ_LIN_FRAME_LOST_MSG,
+    "VV_READ_LIN_FRAME_BREAK_EXPECTED": QUEUE_LOG_MSG_TYPE_dummy_ns.VV_READ_LIN_FRAME_BREAK_EXPECTED,
+    "VV_READ_LIN_FRAME_SYNC_EXPECTED": QUEUE_LOG_MSG_TYPE_dummy_ns.VV_READ_LIN_FRAME_SYNC_EXPECTED,
+    "VV_READ_LIN_FRAME_HEADER_TIMEOUT": QUEUE_LOG_MSG_TYPE_dummy_ns.VV_READ_LIN_FRAME_HEADER_TIMEOUT,
+    "WARN_READ_LIN_FRAME_SID_CRC": QUEUE_LOG_MSG_TYPE_dummy_ns.WARN_READ_LIN_FRAME_SID_CRC,
+    "WARN_READ_LIN_FRAME_LINv1_CRC": QUEUE_LOG_MSG_TYPE_dummy_ns.WARN_READ_LIN_FRAME_LINv1_CRC,
+    "WARN_READ_LIN_FRAME_LINv2_CRC": QUEUE_LOG_MSG_TYPE_dummy_ns.WARN_READ_LIN_FRAME_LINv2_CRC,
+    "INFO_READ_LIN_FRAME_CHECKSUM_MODEL": QUEUE_LOG_MSG_TYPE_dummy_ns.INFO_READ_LIN_FRAME_CHECKSUM_MODEL,
+    "VERBOSE_READ_LIN_FRAME_MSG": QUEUE_LOG_MSG_TYPE_dummy_ns.VERBOSE_READ_LIN_FRAME_MSG,
+}
+
 # [RP2040] Hardware serial of uart validation:
 #   constexpr uint32_t valid_tx_uart_0 = __bitset({0, 12, 16, 28});
 #   constexpr uint32_t valid_tx_uart_1 = __bitset({4, 8, 20, 24});
@@ -201,6 +240,31 @@ def final_validate_device_schema(
     )
 
 
+def validate_uart_isr(value):
+    # `uart_isr_register` was removed in ESP-IDF 5.
+    value = cv.boolean(value)
+    if value and CORE.data[KEY_CORE][KEY_FRAMEWORK_VERSION] >= cv.Version(5, 0, 0):
+        raise cv.Invalid(
+            f"{CONF_UART_ISR} requires ESP-IDF 4, the UART driver is used with ESP-IDF 5 and later."
+        )
+    return value
+
+
+def final_validate_uart_isr(config):
+    # The UART driver of the bus no longer gets interrupts. Nothing else may read, write or debug it.
+    if not config.get(CONF_UART_ISR, False):
+        return config
+    fconf = fv.full_config.get()
+    uart_id = config[CONF_UART_ID]
+    declaration_config = fconf.get_config_for_path(fconf.get_path_for_id(uart_id)[:-1])
+    if CONF_DEBUG in declaration_config:
+        raise cv.Invalid(
+            f"The uart {uart_id} cannot use {CONF_DEBUG} with {CONF_UART_ISR}, "
+            "the UART driver no longer gets interrupts."
+        )
+    return config
+
+
 CONFIG_SCHEMA = cv.All(
     cv.Schema(
         {
@@ -210,23 +274,51 @@ CONFIG_SCHEMA = cv.All(
             cv.Optional(CONF_CS_PIN): pins.gpio_output_pin_schema,
             cv.Optional(CONF_FAULT_PIN): pins.gpio_input_pin_schema,
             cv.Optional(CONF_OBSERVER_MODE): cv.boolean,
+            cv.Optional(CONF_HARDWARE_BREAK): cv.All(cv.only_on(["esp32", "rp2040"]), cv.boolean),
+            cv.Optional(CONF_UART_ISR): cv.All(cv.only_with_esp_idf, validate_uart_isr),
+            cv.Optional(CONF_PIO): cv.All(cv.only_on(["rp2040", "host"]), cv.boolean),
+            cv.Optional(CONF_BAUD_RATE_TRACKING): cv.boolean,
+            # Must end before the frame timeout of 5 byte times after the PID.
+            cv.Optional(CONF_RESPONSE_DELAY): cv.All(
+                cv.positive_time_period_microseconds,
+                cv.Range(max=cv.TimePeriod(microseconds=2000)),
+            ),
+            cv.Optional(CONF_LIN_DATA_LENGTHS): cv.ensure_list(
+                cv.Schema(
+                    {
+                        cv.Required(CONF_PID): cv.hex_int_range(min=0x00, max=0x3F),
+                        cv.Required(CONF_LENGTH): cv.int_range(min=1, max=8),
+                    }
+                )
+            ),
+            # Runtime log filter of the receive path, all types and PIDs by default.
+            cv.Optional(CONF_LOG_TYPES): cv.ensure_list(cv.enum(CONF_SUPPORTED_LOG_TYPE)),
+            cv.Optional(CONF_LOG_PIDS): cv.ensure_list(cv.hex_int_range(min=0x00, max=0x3F)),
             cv.Optional(CONF_ON_HEATER_MESSAGE): automation.validate_automation(
                 {
                     cv.GenerateID(CONF_TRIGGER_ID): cv.declare_id(TrumaiNetBoxAppHeaterMessageTrigger),
                 }
             ),
+            cv.Optional(CONF_ON_LIN_FRAME): automation.validate_automation(
+                {
+                    cv.GenerateID(CONF_TRIGGER_ID): cv.declare_id(TrumaiNetBoxAppLinFrameTrigger),
+                }
+            ),
         }
     )
     # Polling is for presenting data to sensors.
     # Reading and communication is done in a seperate thread/core.
     .extend(cv.polling_component_schema("500ms"))
     .extend(uart.UART_DEVICE_SCHEMA),
-    cv.only_on(["esp32", "rp2040"]),
-)
-FINAL_VALIDATE_SCHEMA = cv.All(
-    final_validate_device_schema(
-        "truma_inetbox", baud_rate=9600, require_tx=True, require_rx=True, stop_bits=2, data_bits=8, parity="NONE", require_hardware_uart=True),
+    cv.only_on(["esp32", "rp2040", "host"]),
 )
+def FINAL_VALIDATE_SCHEMA(config):
+    # The PIO engine can use any pins.
+    require_hardware_uart = None if config.get(CONF_PIO, False) else True
+    config = final_validate_device_schema(
+        "truma_inetbox", baud_rate=9600, require_tx=True, require_rx=True, stop_bits=2, data_bits=8, parity="NONE", require_hardware_uart=require_hardware_uart)(config)
+    return final_validate_uart_isr(config)
+
 
 async def to_code(config):
     if CORE.using_esp_idf:
@@ -257,12 +349,52 @@ async def to_code(config):
     if CONF_OBSERVER_MODE in config:
         cg.add(var.set_observer_mode(config[CONF_OBSERVER_MODE]))
 
+    if CONF_HARDWARE_BREAK in config:
+        cg.add(var.set_hardware_break(config[CONF_HARDWARE_BREAK]))
+
+    if CONF_UART_ISR in config:
+        cg.add(var.set_uart_isr(config[CONF_UART_ISR]))
+
+    if CONF_BAUD_RATE_TRACKING in config:
+        cg.add(var.set_baud_rate_tracking(config[CONF_BAUD_RATE_TRACKING]))
+
+    if CONF_RESPONSE_DELAY in config:
+        cg.add(var.set_response_delay(config[CONF_RESPONSE_DELAY].total_microseconds))
+
+    if CONF_PIO in config:
+        cg.add(var.set_pio(config[CONF_PIO]))
+        if CORE.is_rp2040:
+            uart_config = next(
+                conf for conf in CORE.config["uart"] if conf[CONF_ID] == config[CONF_UART_ID])
+            cg.add(var.set_pio_pins(
+                uart_config[CONF_RX_PIN][CONF_NUMBER], uart_config[CONF_TX_PIN][CONF_NUMBER]))
+
+    for conf in config.get(CONF_LIN_DATA_LENGTHS, []):
+        cg.add(var.set_lin_data_length(conf[CONF_PID], conf[CONF_LENGTH]))
+
+    if CONF_LOG_TYPES in config:
+        cg.add(var.set_log_type_mask(0))
+        for log_type in config[CONF_LOG_TYPES]:
+            cg.add(var.enable_log_type(CONF_SUPPORTED_LOG_TYPE[log_type]))
+
+    if CONF_LOG_PIDS in config:
+        pid_mask = 0
+        for pid in config[CONF_LOG_PIDS]:
+            pid_mask |= 1 << pid
+        cg.add(var.set_log_pid_mask(cg.RawExpression(f"0x{pid_mask:016X}ULL")))
+
     for conf in config.get(CONF_ON_HEATER_MESSAGE, []):
         trigger = cg.new_Pvariable(conf[CONF_TRIGGER_ID], var)
         await automation.build_automation(
             trigger, [(StatusFrameHeaterConstPtr, "message")], conf
         )
 
+    for conf in config.get(CONF_ON_LIN_FRAME, []):
+        trigger = cg.new_Pvariable(conf[CONF_TRIGGER_ID], var)
+        await automation.build_automation(
+            trigger, [(QueueLinFrameConstPtr, "frame")], conf
+        )
+
 
 # AUTOMATION
 
@@ -291,6 +423,12 @@ TimerDisableAction = truma_inetbox_ns.class_(
 TimerActivateAction = truma_inetbox_ns.class_(
     "TimerActivateAction", automation.Action)
 WriteTimeAction = truma_inetbox_ns.class_("WriteTimeAction", automation.Action)
+SetLogFilterAction = truma_inetbox_ns.class_(
+    "SetLogFilterAction", automation.Action)
+DumpLinStatisticsAction = truma_inetbox_ns.class_(
+    "DumpLinStatisticsAction", automation.Action)
+DumpLinTraceAction = truma_inetbox_ns.class_(
+    "DumpLinTraceAction", automation.Action)
 
 # `EnergyMix` is a enum class and not a namespace but it works.
 EnergyMix_dummy_ns = truma_inetbox_ns.namespace("EnergyMix")
@@ -551,3 +689,57 @@ async def truma_inetbox_clock_set_to_code(config, action_id, template_arg, args)
     var = cg.new_Pvariable(action_id, template_arg)
     await cg.register_parented(var, config[CONF_ID])
     return var
+
+
+@automation.register_action(
+    "truma_inetbox.set_log_filter",
+    SetLogFilterAction,
+    automation.maybe_simple_id(
+        {
+            cv.GenerateID(): cv.use_id(TrumaINetBoxApp),
+            cv.Optional(CONF_TYPES): cv.ensure_list(cv.enum(CONF_SUPPORTED_LOG_TYPE)),
+            cv.Optional(CONF_PID): cv.templatable(cv.int_range(min=-1, max=0x3F)),
+        }
+    ),
+)
+async def truma_inetbox_set_log_filter_to_code(config, action_id, template_arg, args):
+    var = cg.new_Pvariable(action_id, template_arg)
+    await cg.register_parented(var, config[CONF_ID])
+
+    for log_type in config.get(CONF_TYPES, []):
+        cg.add(var.add_type(CONF_SUPPORTED_LOG_TYPE[log_type]))
+
+    if CONF_PID in config:
+        template_ = await cg.templatable(config[CONF_PID], args, cg.int16)
+        cg.add(var.set_pid(template_))
+    return var
+
+
+@automation.register_action(
+    "truma_inetbox.dump_lin_statistics",
+    DumpLinStatisticsAction,
+    automation.maybe_simple_id(
+        {
+            cv.GenerateID(): cv.use_id(TrumaINetBoxApp),
+        }
+    ),
+)
+async def truma_inetbox_dump_lin_statistics_to_code(config, action_id, template_arg, args):
+    var = cg.new_Pvariable(action_id, template_arg)
+    await cg.register_parented(var, config[CONF_ID])
+    return var
+
+
+@automation.register_action(
+    "truma_inetbox.dump_lin_trace",
+    DumpLinTraceAction,
+    automation.maybe_simple_id(
+        {
+            cv.GenerateID(): cv.use_id(TrumaINetBoxApp),
+        }
+    ),
+)
+async def truma_inetbox_dump_lin_trace_to_code(config, action_id, template_arg, args):
+    var = cg.new_Pvariable(action_id, template_arg)
+    await cg.register_parented(var, config[CONF_ID])
+    return var
@@ -96,6 +96,41 @@ template<typename... Ts> class WriteTimeAction : public Action<Ts...>, public Pa
 };
 #endif  // USE_TIME
 
+template<typename... Ts> class SetLogFilterAction : public Action<Ts...>, public Parented<TrumaiNetBoxApp> {
+ public:
+  // PID to log, all PIDs if not set or outside 0x00..0x3F.
+  TEMPLATABLE_VALUE(int16_t, pid)
+
+  // Enable `type`. All types are enabled if none was added.
+  void add_type(QUEUE_LOG_MSG_TYPE type) { this->type_mask_ |= TRUMA_LOG_TYPE_BIT(type); }
+
+  void play(Ts... x) override {
+    this->parent_->set_log_type_mask(this->type_mask_ != 0 ? this->type_mask_ : 0xFFFFFFFF);
+    auto pid = this->pid_.value_or(x..., -1);
+    this->parent_->set_log_pid_mask(pid >= 0x00 && pid <= 0x3F ? (uint64_t) 1 << pid : ~(uint64_t) 0);
+  }
+
+ protected:
+  uint32_t type_mask_ = 0;
+};
+
+template<typename... Ts> class DumpLinStatisticsAction : public Action<Ts...>, public Parented<TrumaiNetBoxApp> {
+ public:
+  void play(Ts... x) override { this->parent_->dump_lin_pid_stats(); }
+};
+
+template<typename... Ts> class DumpLinTraceAction : public Action<Ts...>, public Parented<TrumaiNetBoxApp> {
+ public:
+  void play(Ts... x) override { this->parent_->dump_lin_trace(); }
+};
+
+class TrumaiNetBoxAppLinFrameTrigger : public Trigger<const QUEUE_LIN_FRAME *> {
+ public:
+  explicit TrumaiNetBoxAppLinFrameTrigger(TrumaiNetBoxApp *parent) {
+    parent->add_on_lin_frame_callback([this](const QUEUE_LIN_FRAME *frame) { this->trigger(frame); });
+  }
+};
+
 class TrumaiNetBoxAppHeaterMessageTrigger : public Trigger<const StatusFrameHeater *> {
  public:
   explicit TrumaiNetBoxAppHeaterMessageTrigger(TrumaiNetBoxApp *parent) {
@@ -12,8 +12,8 @@ void TrumaCpPlusBinarySensor::update() {
     this->publish_state(false);
     return;
   }
-  const auto timeout = this->parent_->get_last_cp_plus_request() + 90 * 1000 * 1000 /* 90 seconds*/;
-  this->publish_state(micros() < timeout);
+  const auto since_request = lin_micros64() - this->parent_->get_last_cp_plus_request();
+  this->publish_state(since_request < 90 * 1000 * 1000 /* 90 seconds*/);
 }
 
 void TrumaCpPlusBinarySensor::dump_config() { LOG_BINARY_SENSOR("", "Truma CP Plus Binary Sensor", this); }
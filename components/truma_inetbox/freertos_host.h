@@ -0,0 +1,14 @@
+#pragma once
+
+#ifdef USE_HOST
+
+#include <cstdint>
+
+// Minimal stand-in for the FreeRTOS types used by the LIN stack. The host build runs single threaded: the LIN message
+// queue is processed right after data was recieved, so a requested wait time is never used.
+
+typedef uint32_t TickType_t;
+
+#define portMAX_DELAY ((TickType_t) 0xFFFFFFFFUL)
+
+#endif  // USE_HOST
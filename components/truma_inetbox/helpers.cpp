@@ -3,6 +3,25 @@
 namespace esphome {
 namespace truma_inetbox {
 
+HexPrettyString format_hex_pretty_fixed(const u_int8_t *data, size_t length) {
+  static const char *const HEX = "0123456789ABCDEF";
+  HexPrettyString ret;
+  char *pos = ret.str;
+  auto count = length < HEX_PRETTY_MAX_LENGTH ? length : HEX_PRETTY_MAX_LENGTH;
+  for (size_t i = 0; i < count; i++) {
+    if (i > 0) {
+      *pos++ = '.';
+    }
+    *pos++ = HEX[data[i] >> 4];
+    *pos++ = HEX[data[i] & 0x0F];
+  }
+  *pos = '\0';
+  if (length > 4) {
+    snprintf(pos, sizeof(ret.str) - (pos - ret.str), " (%u)", (unsigned) length);
+  }
+  return ret;
+}
+
 u_int8_t addr_parity(const u_int8_t PID) {
   u_int8_t P0 = ((PID >> 0) + (PID >> 1) + (PID >> 2) + (PID >> 4)) & 1;
   u_int8_t P1 = ~((PID >> 1) + (PID >> 3) + (PID >> 4) + (PID >> 5)) & 1;
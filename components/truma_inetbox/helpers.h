@@ -12,6 +12,18 @@ const std::array<u_int8_t, 11> truma_message_header = {0x00, 0x00, 0x1F, 0x00, 0
                                                        0x00, 0x22, 0xFF, 0xFF, 0xFF};
 const std::array<u_int8_t, 11> alde_message_header = {0x00, 0x00, 0x1F, 0x00, 0x1A, 0x00, 0x00, 0x22, 0xFF, 0xFF, 0xFF};
 
+// Longest payload of `format_hex_pretty_fixed`, a multi PDU message.
+static const size_t HEX_PRETTY_MAX_LENGTH = 64;
+// Result of `format_hex_pretty_fixed`, lives on the stack of the caller.
+struct HexPrettyString {
+  // "XX." per byte and " (64)".
+  char str[HEX_PRETTY_MAX_LENGTH * 3 + 6];
+  const char *c_str() const { return this->str; }
+};
+// Same output as `format_hex_pretty` without heap allocation. Only the first `HEX_PRETTY_MAX_LENGTH` bytes are
+// formatted.
+HexPrettyString format_hex_pretty_fixed(const u_int8_t *data, size_t length);
+
 u_int8_t addr_parity(const u_int8_t pid);
 u_int8_t data_checksum(const u_int8_t *message, u_int8_t length, uint16_t sum);
 float temp_code_to_decimal(u_int16_t val, float zero = NAN);
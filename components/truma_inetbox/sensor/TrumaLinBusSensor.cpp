@@ -0,0 +1,188 @@
+#include "TrumaLinBusSensor.h"
+#include "esphome/core/log.h"
+
+namespace esphome {
+namespace truma_inetbox {
+
+static const char *const TAG = "truma_inetbox.lin_bus_sensor";
+
+void TrumaLinBusSensor::update() {
+  LinBusQueueStats *stats = nullptr;
+  switch (this->type_) {
+    case TRUMA_LIN_BUS_SENSOR_TYPE::LIN_BREAK_TO_SYNC_P50:
+    case TRUMA_LIN_BUS_SENSOR_TYPE::LIN_BREAK_TO_SYNC_P95:
+    case TRUMA_LIN_BUS_SENSOR_TYPE::LIN_BREAK_TO_SYNC_MAX:
+    case TRUMA_LIN_BUS_SENSOR_TYPE::LIN_HEADER_TO_RESPONSE_P50:
+    case TRUMA_LIN_BUS_SENSOR_TYPE::LIN_HEADER_TO_RESPONSE_P95:
+    case TRUMA_LIN_BUS_SENSOR_TYPE::LIN_HEADER_TO_RESPONSE_MAX:
+    case TRUMA_LIN_BUS_SENSOR_TYPE::LIN_INTER_BYTE_GAP_P50:
+    case TRUMA_LIN_BUS_SENSOR_TYPE::LIN_INTER_BYTE_GAP_P95:
+    case TRUMA_LIN_BUS_SENSOR_TYPE::LIN_INTER_BYTE_GAP_MAX:
+    case TRUMA_LIN_BUS_SENSOR_TYPE::LIN_RESPONSE_JITTER_P50:
+    case TRUMA_LIN_BUS_SENSOR_TYPE::LIN_RESPONSE_JITTER_P95:
+    case TRUMA_LIN_BUS_SENSOR_TYPE::LIN_RESPONSE_JITTER_MAX:
+      this->update_histogram_();
+      return;
+    case TRUMA_LIN_BUS_SENSOR_TYPE::LIN_FRAMES:
+    case TRUMA_LIN_BUS_SENSOR_TYPE::LIN_VALID_FRAMES:
+    case TRUMA_LIN_BUS_SENSOR_TYPE::LIN_SID_PARITY_ERRORS:
+    case TRUMA_LIN_BUS_SENSOR_TYPE::LIN_CRC_ERRORS:
+    case TRUMA_LIN_BUS_SENSOR_TYPE::LIN_LOST_FRAMES:
+    case TRUMA_LIN_BUS_SENSOR_TYPE::LIN_PARTIAL_FRAMES:
+    case TRUMA_LIN_BUS_SENSOR_TYPE::LIN_ANSWERED_ORDERS:
+    case TRUMA_LIN_BUS_SENSOR_TYPE::LIN_PID_INTERVAL:
+    case TRUMA_LIN_BUS_SENSOR_TYPE::LIN_PID_JITTER:
+      this->update_pid_stats_();
+      return;
+    case TRUMA_LIN_BUS_SENSOR_TYPE::LIN_BAUD_RATE:
+      this->publish_state(this->parent_->get_measured_baud_rate());
+      return;
+    case TRUMA_LIN_BUS_SENSOR_TYPE::LIN_ANSWER_COLLISIONS:
+      this->publish_state(static_cast<float>(this->parent_->get_lin_answer_collisions()));
+      return;
+    case TRUMA_LIN_BUS_SENSOR_TYPE::LIN_ANSWER_BIT_ERRORS:
+      this->publish_state(static_cast<float>(this->parent_->get_lin_answer_bit_errors()));
+      return;
+    case TRUMA_LIN_BUS_SENSOR_TYPE::LIN_MSG_QUEUE_ENQUEUED:
+    case TRUMA_LIN_BUS_SENSOR_TYPE::LIN_MSG_QUEUE_DROPPED:
+    case TRUMA_LIN_BUS_SENSOR_TYPE::LIN_MSG_QUEUE_HIGH_WATER:
+    case TRUMA_LIN_BUS_SENSOR_TYPE::LIN_MSG_QUEUE_LATENCY:
+      stats = this->parent_->get_lin_msg_queue_stats();
+      break;
+    default:
+      stats = this->parent_->get_log_queue_stats();
+      break;
+  }
+  if (stats == nullptr) {
+    // Log queue is compiled out with `logger: level: NONE`.
+    this->publish_state(NAN);
+    return;
+  }
+
+  switch (this->type_) {
+    case TRUMA_LIN_BUS_SENSOR_TYPE::LIN_MSG_QUEUE_ENQUEUED:
+    case TRUMA_LIN_BUS_SENSOR_TYPE::LOG_QUEUE_ENQUEUED:
+      this->publish_state(static_cast<float>(stats->get_enqueued()));
+      break;
+    case TRUMA_LIN_BUS_SENSOR_TYPE::LIN_MSG_QUEUE_DROPPED:
+    case TRUMA_LIN_BUS_SENSOR_TYPE::LOG_QUEUE_DROPPED:
+      this->publish_state(static_cast<float>(stats->get_dropped()));
+      break;
+    case TRUMA_LIN_BUS_SENSOR_TYPE::LIN_MSG_QUEUE_HIGH_WATER:
+    case TRUMA_LIN_BUS_SENSOR_TYPE::LOG_QUEUE_HIGH_WATER:
+      this->publish_state(static_cast<float>(stats->get_high_water()));
+      break;
+    case TRUMA_LIN_BUS_SENSOR_TYPE::LIN_MSG_QUEUE_LATENCY:
+    case TRUMA_LIN_BUS_SENSOR_TYPE::LOG_QUEUE_LATENCY:
+      // Longest wait since the last update.
+      this->publish_state(static_cast<float>(stats->take_latency_max()));
+      break;
+    default:
+      break;
+  }
+}
+
+void TrumaLinBusSensor::update_histogram_() {
+  LinBusHistogram *histogram = nullptr;
+  switch (this->type_) {
+    case TRUMA_LIN_BUS_SENSOR_TYPE::LIN_BREAK_TO_SYNC_P50:
+    case TRUMA_LIN_BUS_SENSOR_TYPE::LIN_BREAK_TO_SYNC_P95:
+    case TRUMA_LIN_BUS_SENSOR_TYPE::LIN_BREAK_TO_SYNC_MAX:
+      histogram = this->parent_->get_break_to_sync_histogram();
+      break;
+    case TRUMA_LIN_BUS_SENSOR_TYPE::LIN_HEADER_TO_RESPONSE_P50:
+    case TRUMA_LIN_BUS_SENSOR_TYPE::LIN_HEADER_TO_RESPONSE_P95:
+    case TRUMA_LIN_BUS_SENSOR_TYPE::LIN_HEADER_TO_RESPONSE_MAX:
+      histogram = this->parent_->get_header_to_response_histogram();
+      break;
+    case TRUMA_LIN_BUS_SENSOR_TYPE::LIN_RESPONSE_JITTER_P50:
+    case TRUMA_LIN_BUS_SENSOR_TYPE::LIN_RESPONSE_JITTER_P95:
+    case TRUMA_LIN_BUS_SENSOR_TYPE::LIN_RESPONSE_JITTER_MAX:
+      histogram = this->parent_->get_response_jitter_histogram();
+      break;
+    default:
+      histogram = this->parent_->get_inter_byte_gap_histogram();
+      break;
+  }
+  if (histogram->get_count() == 0) {
+    this->publish_state(NAN);
+    return;
+  }
+
+  switch (this->type_) {
+    case TRUMA_LIN_BUS_SENSOR_TYPE::LIN_BREAK_TO_SYNC_P50:
+    case TRUMA_LIN_BUS_SENSOR_TYPE::LIN_HEADER_TO_RESPONSE_P50:
+    case TRUMA_LIN_BUS_SENSOR_TYPE::LIN_INTER_BYTE_GAP_P50:
+    case TRUMA_LIN_BUS_SENSOR_TYPE::LIN_RESPONSE_JITTER_P50:
+      this->publish_state(static_cast<float>(histogram->get_percentile(50)));
+      break;
+    case TRUMA_LIN_BUS_SENSOR_TYPE::LIN_BREAK_TO_SYNC_P95:
+    case TRUMA_LIN_BUS_SENSOR_TYPE::LIN_HEADER_TO_RESPONSE_P95:
+    case TRUMA_LIN_BUS_SENSOR_TYPE::LIN_INTER_BYTE_GAP_P95:
+    case TRUMA_LIN_BUS_SENSOR_TYPE::LIN_RESPONSE_JITTER_P95:
+      this->publish_state(static_cast<float>(histogram->get_percentile(95)));
+      break;
+    default:
+      // Longest duration since the last update.
+      this->publish_state(static_cast<float>(histogram->take_max()));
+      break;
+  }
+}
+
+void TrumaLinBusSensor::update_pid_stats_() {
+  if (this->type_ == TRUMA_LIN_BUS_SENSOR_TYPE::LIN_PID_INTERVAL ||
+      this->type_ == TRUMA_LIN_BUS_SENSOR_TYPE::LIN_PID_JITTER) {
+    auto stats = this->parent_->get_lin_pid_stats(this->pid_);
+    if (stats->frames < 2) {
+      this->publish_state(NAN);
+    } else if (this->type_ == TRUMA_LIN_BUS_SENSOR_TYPE::LIN_PID_INTERVAL) {
+      this->publish_state(static_cast<float>(stats->interval));
+    } else {
+      this->publish_state(static_cast<float>(stats->jitter));
+    }
+    return;
+  }
+
+  uint32_t sum = 0;
+  for (u_int8_t pid = 0; pid < 64; pid++) {
+    if (this->pid_ >= 0 && this->pid_ != pid) {
+      continue;
+    }
+    auto stats = this->parent_->get_lin_pid_stats(pid);
+    switch (this->type_) {
+      case TRUMA_LIN_BUS_SENSOR_TYPE::LIN_FRAMES:
+        sum += stats->frames;
+        break;
+      case TRUMA_LIN_BUS_SENSOR_TYPE::LIN_VALID_FRAMES:
+        sum += stats->valid_frames;
+        break;
+      case TRUMA_LIN_BUS_SENSOR_TYPE::LIN_SID_PARITY_ERRORS:
+        sum += stats->sid_parity_errors;
+        break;
+      case TRUMA_LIN_BUS_SENSOR_TYPE::LIN_CRC_ERRORS:
+        sum += stats->crc_v1_errors + stats->crc_v2_errors;
+        break;
+      case TRUMA_LIN_BUS_SENSOR_TYPE::LIN_LOST_FRAMES:
+        sum += stats->lost_frames;
+        break;
+      case TRUMA_LIN_BUS_SENSOR_TYPE::LIN_PARTIAL_FRAMES:
+        sum += stats->partial_frames;
+        break;
+      default:
+        sum += stats->answered;
+        break;
+    }
+  }
+  this->publish_state(static_cast<float>(sum));
+}
+
+void TrumaLinBusSensor::dump_config() {
+  LOG_SENSOR("", "Truma LIN Bus Sensor", this);
+  ESP_LOGCONFIG(TAG, "  Type '%s'", enum_to_c_str(this->type_));
+  if (this->pid_ >= 0) {
+    ESP_LOGCONFIG(TAG, "  PID %02X", this->pid_);
+  }
+  LOG_UPDATE_INTERVAL(this);
+}
+}  // namespace truma_inetbox
+}  // namespace esphome
@@ -0,0 +1,170 @@
+#pragma once
+
+#include "esphome/core/log.h"
+#include "esphome/components/sensor/sensor.h"
+#include "esphome/components/truma_inetbox/TrumaiNetBoxApp.h"
+
+namespace esphome {
+namespace truma_inetbox {
+enum class TRUMA_LIN_BUS_SENSOR_TYPE {
+  UNKNOWN,
+  LIN_MSG_QUEUE_ENQUEUED,
+  LIN_MSG_QUEUE_DROPPED,
+  LIN_MSG_QUEUE_HIGH_WATER,
+  LIN_MSG_QUEUE_LATENCY,
+  LOG_QUEUE_ENQUEUED,
+  LOG_QUEUE_DROPPED,
+  LOG_QUEUE_HIGH_WATER,
+  LOG_QUEUE_LATENCY,
+  LIN_BREAK_TO_SYNC_P50,
+  LIN_BREAK_TO_SYNC_P95,
+  LIN_BREAK_TO_SYNC_MAX,
+  LIN_HEADER_TO_RESPONSE_P50,
+  LIN_HEADER_TO_RESPONSE_P95,
+  LIN_HEADER_TO_RESPONSE_MAX,
+  LIN_INTER_BYTE_GAP_P50,
+  LIN_INTER_BYTE_GAP_P95,
+  LIN_INTER_BYTE_GAP_MAX,
+  LIN_BAUD_RATE,
+  LIN_ANSWER_COLLISIONS,
+  LIN_ANSWER_BIT_ERRORS,
+  LIN_RESPONSE_JITTER_P50,
+  LIN_RESPONSE_JITTER_P95,
+  LIN_RESPONSE_JITTER_MAX,
+  LIN_FRAMES,
+  LIN_VALID_FRAMES,
+  LIN_SID_PARITY_ERRORS,
+  LIN_CRC_ERRORS,
+  LIN_LOST_FRAMES,
+  LIN_PARTIAL_FRAMES,
+  LIN_ANSWERED_ORDERS,
+  LIN_PID_INTERVAL,
+  LIN_PID_JITTER,
+};
+
+#ifdef ESPHOME_LOG_HAS_CONFIG
+static const char *enum_to_c_str(const TRUMA_LIN_BUS_SENSOR_TYPE val) {
+  switch (val) {
+    case TRUMA_LIN_BUS_SENSOR_TYPE::LIN_MSG_QUEUE_ENQUEUED:
+      return "LIN_MSG_QUEUE_ENQUEUED";
+      break;
+    case TRUMA_LIN_BUS_SENSOR_TYPE::LIN_MSG_QUEUE_DROPPED:
+      return "LIN_MSG_QUEUE_DROPPED";
+      break;
+    case TRUMA_LIN_BUS_SENSOR_TYPE::LIN_MSG_QUEUE_HIGH_WATER:
+      return "LIN_MSG_QUEUE_HIGH_WATER";
+      break;
+    case TRUMA_LIN_BUS_SENSOR_TYPE::LIN_MSG_QUEUE_LATENCY:
+      return "LIN_MSG_QUEUE_LATENCY";
+      break;
+    case TRUMA_LIN_BUS_SENSOR_TYPE::LOG_QUEUE_ENQUEUED:
+      return "LOG_QUEUE_ENQUEUED";
+      break;
+    case TRUMA_LIN_BUS_SENSOR_TYPE::LOG_QUEUE_DROPPED:
+      return "LOG_QUEUE_DROPPED";
+      break;
+    case TRUMA_LIN_BUS_SENSOR_TYPE::LOG_QUEUE_HIGH_WATER:
+      return "LOG_QUEUE_HIGH_WATER";
+      break;
+    case TRUMA_LIN_BUS_SENSOR_TYPE::LOG_QUEUE_LATENCY:
+      return "LOG_QUEUE_LATENCY";
+      break;
+    case TRUMA_LIN_BUS_SENSOR_TYPE::LIN_BREAK_TO_SYNC_P50:
+      return "LIN_BREAK_TO_SYNC_P50";
+      break;
+    case TRUMA_LIN_BUS_SENSOR_TYPE::LIN_BREAK_TO_SYNC_P95:
+      return "LIN_BREAK_TO_SYNC_P95";
+      break;
+    case TRUMA_LIN_BUS_SENSOR_TYPE::LIN_BREAK_TO_SYNC_MAX:
+      return "LIN_BREAK_TO_SYNC_MAX";
+      break;
+    case TRUMA_LIN_BUS_SENSOR_TYPE::LIN_HEADER_TO_RESPONSE_P50:
+      return "LIN_HEADER_TO_RESPONSE_P50";
+      break;
+    case TRUMA_LIN_BUS_SENSOR_TYPE::LIN_HEADER_TO_RESPONSE_P95:
+      return "LIN_HEADER_TO_RESPONSE_P95";
+      break;
+    case TRUMA_LIN_BUS_SENSOR_TYPE::LIN_HEADER_TO_RESPONSE_MAX:
+      return "LIN_HEADER_TO_RESPONSE_MAX";
+      break;
+    case TRUMA_LIN_BUS_SENSOR_TYPE::LIN_INTER_BYTE_GAP_P50:
+      return "LIN_INTER_BYTE_GAP_P50";
+      break;
+    case TRUMA_LIN_BUS_SENSOR_TYPE::LIN_INTER_BYTE_GAP_P95:
+      return "LIN_INTER_BYTE_GAP_P95";
+      break;
+    case TRUMA_LIN_BUS_SENSOR_TYPE::LIN_INTER_BYTE_GAP_MAX:
+      return "LIN_INTER_BYTE_GAP_MAX";
+      break;
+    case TRUMA_LIN_BUS_SENSOR_TYPE::LIN_BAUD_RATE:
+      return "LIN_BAUD_RATE";
+      break;
+    case TRUMA_LIN_BUS_SENSOR_TYPE::LIN_ANSWER_COLLISIONS:
+      return "LIN_ANSWER_COLLISIONS";
+      break;
+    case TRUMA_LIN_BUS_SENSOR_TYPE::LIN_ANSWER_BIT_ERRORS:
+      return "LIN_ANSWER_BIT_ERRORS";
+      break;
+    case TRUMA_LIN_BUS_SENSOR_TYPE::LIN_RESPONSE_JITTER_P50:
+      return "LIN_RESPONSE_JITTER_P50";
+      break;
+    case TRUMA_LIN_BUS_SENSOR_TYPE::LIN_RESPONSE_JITTER_P95:
+      return "LIN_RESPONSE_JITTER_P95";
+      break;
+    case TRUMA_LIN_BUS_SENSOR_TYPE::LIN_RESPONSE_JITTER_MAX:
+      return "LIN_RESPONSE_JITTER_MAX";
+      break;
+    case TRUMA_LIN_BUS_SENSOR_TYPE::LIN_FRAMES:
+      return "LIN_FRAMES";
+      break;
+    case TRUMA_LIN_BUS_SENSOR_TYPE::LIN_VALID_FRAMES:
+      return "LIN_VALID_FRAMES";
+      break;
+    case TRUMA_LIN_BUS_SENSOR_TYPE::LIN_SID_PARITY_ERRORS:
+      return "LIN_SID_PARITY_ERRORS";
+      break;
+    case TRUMA_LIN_BUS_SENSOR_TYPE::LIN_CRC_ERRORS:
+      return "LIN_CRC_ERRORS";
+      break;
+    case TRUMA_LIN_BUS_SENSOR_TYPE::LIN_LOST_FRAMES:
+      return "LIN_LOST_FRAMES";
+      break;
+    case TRUMA_LIN_BUS_SENSOR_TYPE::LIN_PARTIAL_FRAMES:
+      return "LIN_PARTIAL_FRAMES";
+      break;
+    case TRUMA_LIN_BUS_SENSOR_TYPE::LIN_ANSWERED_ORDERS:
+      return "LIN_ANSWERED_ORDERS";
+      break;
+    case TRUMA_LIN_BUS_SENSOR_TYPE::LIN_PID_INTERVAL:
+      return "LIN_PID_INTERVAL";
+      break;
+    case TRUMA_LIN_BUS_SENSOR_TYPE::LIN_PID_JITTER:
+      return "LIN_PID_JITTER";
+      break;
+    default:
+      return "";
+      break;
+  }
+}
+#endif  // ESPHOME_LOG_HAS_CONFIG
+
+// Diagnostic values of the LIN bus listener, polled every `update_interval`.
+class TrumaLinBusSensor : public PollingComponent, public sensor::Sensor, public Parented<TrumaiNetBoxApp> {
+ public:
+  void update() override;
+  void dump_config() override;
+
+  void set_type(TRUMA_LIN_BUS_SENSOR_TYPE val) { this->type_ = val; }
+  // Restrict the PID statistics to one PID. All PIDs are summed up otherwise.
+  void set_pid(u_int8_t val) { this->pid_ = val; }
+
+ protected:
+  TRUMA_LIN_BUS_SENSOR_TYPE type_;
+  int16_t pid_ = -1;
+
+ private:
+  void update_histogram_();
+  void update_pid_stats_();
+};
+}  // namespace truma_inetbox
+}  // namespace esphome
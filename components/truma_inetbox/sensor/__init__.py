@@ -4,6 +4,7 @@ import esphome.codegen as cg
 from esphome.const import (
     CONF_ID,
     CONF_TYPE,
+    CONF_UPDATE_INTERVAL,
     DEVICE_CLASS_POWER,
     DEVICE_CLASS_TEMPERATURE,
     CONF_UNIT_OF_MEASUREMENT,
@@ -18,12 +19,13 @@ from esphome.const import (
     ICON_GAS_CYLINDER,
     ICON_POWER,
 )
-from .. import truma_inetbox_ns, CONF_TRUMA_INETBOX_ID, TrumaINetBoxApp
+from .. import truma_inetbox_ns, CONF_TRUMA_INETBOX_ID, CONF_PID, TrumaINetBoxApp
 
 DEPENDENCIES = ["truma_inetbox"]
 CODEOWNERS = ["@Fabian-Schmidt"]
 
 CONF_CLASS = "class"
+CONF_CPP_CLASS = "cpp_class"
 
 TrumaSensor = truma_inetbox_ns.class_(
     "TrumaSensor", sensor.Sensor, cg.Component)
@@ -31,6 +33,16 @@ TrumaSensor = truma_inetbox_ns.class_(
 # `TRUMA_SENSOR_TYPE` is a enum class and not a namespace but it works.
 TRUMA_SENSOR_TYPE_dummy_ns = truma_inetbox_ns.namespace("TRUMA_SENSOR_TYPE")
 
+TrumaLinBusSensor = truma_inetbox_ns.class_(
+    "TrumaLinBusSensor", sensor.Sensor, cg.PollingComponent)
+
+# `TRUMA_LIN_BUS_SENSOR_TYPE` is a enum class and not a namespace but it works.
+TRUMA_LIN_BUS_SENSOR_TYPE_dummy_ns = truma_inetbox_ns.namespace(
+    "TRUMA_LIN_BUS_SENSOR_TYPE")
+
+UNIT_MICROSECOND = "µs"
+UNIT_BAUD = "Bd"
+
 CONF_SUPPORTED_TYPE = {
     "CURRENT_ROOM_TEMPERATURE": {
         CONF_CLASS: TRUMA_SENSOR_TYPE_dummy_ns.CURRENT_ROOM_TEMPERATURE,
@@ -87,12 +99,233 @@ CONF_SUPPORTED_TYPE = {
         CONF_UNIT_OF_MEASUREMENT: UNIT_EMPTY,
         CONF_ACCURACY_DECIMALS: 0,
     },
+    "LIN_MSG_QUEUE_ENQUEUED": {
+        CONF_CLASS: TRUMA_LIN_BUS_SENSOR_TYPE_dummy_ns.LIN_MSG_QUEUE_ENQUEUED,
+        CONF_CPP_CLASS: TrumaLinBusSensor,
+        CONF_UNIT_OF_MEASUREMENT: UNIT_EMPTY,
+        CONF_ACCURACY_DECIMALS: 0,
+    },
+    "LIN_MSG_QUEUE_DROPPED": {
+        CONF_CLASS: TRUMA_LIN_BUS_SENSOR_TYPE_dummy_ns.LIN_MSG_QUEUE_DROPPED,
+        CONF_CPP_CLASS: TrumaLinBusSensor,
+        CONF_UNIT_OF_MEASUREMENT: UNIT_EMPTY,
+        CONF_ACCURACY_DECIMALS: 0,
+    },
+    "LIN_MSG_QUEUE_HIGH_WATER": {
+        CONF_CLASS: TRUMA_LIN_BUS_SENSOR_TYPE_dummy_ns.LIN_MSG_QUEUE_HIGH_WATER,
+        CONF_CPP_CLASS: TrumaLinBusSensor,
+        CONF_UNIT_OF_MEASUREMENT: UNIT_EMPTY,
+        CONF_ACCURACY_DECIMALS: 0,
+    },
+    "LIN_MSG_QUEUE_LATENCY": {
+        CONF_CLASS: TRUMA_LIN_BUS_SENSOR_TYPE_dummy_ns.LIN_MSG_QUEUE_LATENCY,
+        CONF_CPP_CLASS: TrumaLinBusSensor,
+        CONF_UNIT_OF_MEASUREMENT: UNIT_MICROSECOND,
+        CONF_ACCURACY_DECIMALS: 0,
+    },
+    "LOG_QUEUE_ENQUEUED": {
+        CONF_CLASS: TRUMA_LIN_BUS_SENSOR_TYPE_dummy_ns.LOG_QUEUE_ENQUEUED,
+        CONF_CPP_CLASS: TrumaLinBusSensor,
+        CONF_UNIT_OF_MEASUREMENT: UNIT_EMPTY,
+        CONF_ACCURACY_DECIMALS: 0,
+    },
+    "LOG_QUEUE_DROPPED": {
+        CONF_CLASS: TRUMA_LIN_BUS_SENSOR_TYPE_dummy_ns.LOG_QUEUE_DROPPED,
+        CONF_CPP_CLASS: TrumaLinBusSensor,
+        CONF_UNIT_OF_MEASUREMENT: UNIT_EMPTY,
+        CONF_ACCURACY_DECIMALS: 0,
+    },
+    "LOG_QUEUE_HIGH_WATER": {
+        CONF_CLASS: TRUMA_LIN_BUS_SENSOR_TYPE_dummy_ns.LOG_QUEUE_HIGH_WATER,
+        CONF_CPP_CLASS: TrumaLinBusSensor,
+        CONF_UNIT_OF_MEASUREMENT: UNIT_EMPTY,
+        CONF_ACCURACY_DECIMALS: 0,
+    },
+    "LOG_QUEUE_LATENCY": {
+        CONF_CLASS: TRUMA_LIN_BUS_SENSOR_TYPE_dummy_ns.LOG_QUEUE_LATENCY,
+        CONF_CPP_CLASS: TrumaLinBusSensor,
+        CONF_UNIT_OF_MEASUREMENT: UNIT_MICROSECOND,
+        CONF_ACCURACY_DECIMALS: 0,
+    },
+    "LIN_BREAK_TO_SYNC_P50": {
+        CONF_CLASS: TRUMA_LIN_BUS_SENSOR_TYPE_dummy_ns.LIN_BREAK_TO_SYNC_P50,
+        CONF_CPP_CLASS: TrumaLinBusSensor,
+        CONF_UNIT_OF_MEASUREMENT: UNIT_MICROSECOND,
+        CONF_ACCURACY_DECIMALS: 0,
+    },
+    "LIN_BREAK_TO_SYNC_P95": {
+        CONF_CLASS: TRUMA_LIN_BUS_SENSOR_TYPE_dummy_ns.LIN_BREAK_TO_SYNC_P95,
+        CONF_CPP_CLASS: TrumaLinBusSensor,
+        CONF_UNIT_OF_MEASUREMENT: UNIT_MICROSECOND,
+        CONF_ACCURACY_DECIMALS: 0,
+    },
+    "LIN_BREAK_TO_SYNC_MAX": {
+        CONF_CLASS: TRUMA_LIN_BUS_SENSOR_TYPE_dummy_ns.LIN_BREAK_TO_SYNC_MAX,
+        CONF_CPP_CLASS: TrumaLinBusSensor,
+        CONF_UNIT_OF_MEASUREMENT: UNIT_MICROSECOND,
+        CONF_ACCURACY_DECIMALS: 0,
+    },
+    "LIN_HEADER_TO_RESPONSE_P50": {
+        CONF_CLASS: TRUMA_LIN_BUS_SENSOR_TYPE_dummy_ns.LIN_HEADER_TO_RESPONSE_P50,
+        CONF_CPP_CLASS: TrumaLinBusSensor,
+        CONF_UNIT_OF_MEASUREMENT: UNIT_MICROSECOND,
+        CONF_ACCURACY_DECIMALS: 0,
+    },
+    "LIN_HEADER_TO_RESPONSE_P95": {
+        CONF_CLASS: TRUMA_LIN_BUS_SENSOR_TYPE_dummy_ns.LIN_HEADER_TO_RESPONSE_P95,
+        CONF_CPP_CLASS: TrumaLinBusSensor,
+        CONF_UNIT_OF_MEASUREMENT: UNIT_MICROSECOND,
+        CONF_ACCURACY_DECIMALS: 0,
+    },
+    "LIN_HEADER_TO_RESPONSE_MAX": {
+        CONF_CLASS: TRUMA_LIN_BUS_SENSOR_TYPE_dummy_ns.LIN_HEADER_TO_RESPONSE_MAX,
+        CONF_CPP_CLASS: TrumaLinBusSensor,
+        CONF_UNIT_OF_MEASUREMENT: UNIT_MICROSECOND,
+        CONF_ACCURACY_DECIMALS: 0,
+    },
+    "LIN_INTER_BYTE_GAP_P50": {
+        CONF_CLASS: TRUMA_LIN_BUS_SENSOR_TYPE_dummy_ns.LIN_INTER_BYTE_GAP_P50,
+        CONF_CPP_CLASS: TrumaLinBusSensor,
+        CONF_UNIT_OF_MEASUREMENT: UNIT_MICROSECOND,
+        CONF_ACCURACY_DECIMALS: 0,
+    },
+    "LIN_INTER_BYTE_GAP_P95": {
+        CONF_CLASS: TRUMA_LIN_BUS_SENSOR_TYPE_dummy_ns.LIN_INTER_BYTE_GAP_P95,
+        CONF_CPP_CLASS: TrumaLinBusSensor,
+        CONF_UNIT_OF_MEASUREMENT: UNIT_MICROSECOND,
+        CONF_ACCURACY_DECIMALS: 0,
+    },
+    "LIN_INTER_BYTE_GAP_MAX": {
+        CONF_CLASS: TRUMA_LIN_BUS_SENSOR_TYPE_dummy_ns.LIN_INTER_BYTE_GAP_MAX,
+        CONF_CPP_CLASS: TrumaLinBusSensor,
+        CONF_UNIT_OF_MEASUREMENT: UNIT_MICROSECOND,
+        CONF_ACCURACY_DECIMALS: 0,
+    },
+    "LIN_BAUD_RATE": {
+        CONF_CLASS: TRUMA_LIN_BUS_SENSOR_TYPE_dummy_ns.LIN_BAUD_RATE,
+        CONF_CPP_CLASS: TrumaLinBusSensor,
+        CONF_UNIT_OF_MEASUREMENT: UNIT_BAUD,
+        CONF_ACCURACY_DECIMALS: 0,
+    },
+    "LIN_ANSWER_COLLISIONS": {
+        CONF_CLASS: TRUMA_LIN_BUS_SENSOR_TYPE_dummy_ns.LIN_ANSWER_COLLISIONS,
+        CONF_CPP_CLASS: TrumaLinBusSensor,
+        CONF_UNIT_OF_MEASUREMENT: UNIT_EMPTY,
+        CONF_ACCURACY_DECIMALS: 0,
+    },
+    "LIN_ANSWER_BIT_ERRORS": {
+        CONF_CLASS: TRUMA_LIN_BUS_SENSOR_TYPE_dummy_ns.LIN_ANSWER_BIT_ERRORS,
+        CONF_CPP_CLASS: TrumaLinBusSensor,
+        CONF_UNIT_OF_MEASUREMENT: UNIT_EMPTY,
+        CONF_ACCURACY_DECIMALS: 0,
+    },
+    "LIN_RESPONSE_JITTER_P50": {
+        CONF_CLASS: TRUMA_LIN_BUS_SENSOR_TYPE_dummy_ns.LIN_RESPONSE_JITTER_P50,
+        CONF_CPP_CLASS: TrumaLinBusSensor,
+        CONF_UNIT_OF_MEASUREMENT: UNIT_MICROSECOND,
+        CONF_ACCURACY_DECIMALS: 0,
+    },
+    "LIN_RESPONSE_JITTER_P95": {
+        CONF_CLASS: TRUMA_LIN_BUS_SENSOR_TYPE_dummy_ns.LIN_RESPONSE_JITTER_P95,
+        CONF_CPP_CLASS: TrumaLinBusSensor,
+        CONF_UNIT_OF_MEASUREMENT: UNIT_MICROSECOND,
+        CONF_ACCURACY_DECIMALS: 0,
+    },
+    "LIN_RESPONSE_JITTER_MAX": {
+        CONF_CLASS: TRUMA_LIN_BUS_SENSOR_TYPE_dummy_ns.LIN_RESPONSE_JITTER_MAX,
+        CONF_CPP_CLASS: TrumaLinBusSensor,
+        CONF_UNIT_OF_MEASUREMENT: UNIT_MICROSECOND,
+        CONF_ACCURACY_DECIMALS: 0,
+    },
+    "LIN_FRAMES": {
+        CONF_CLASS: TRUMA_LIN_BUS_SENSOR_TYPE_dummy_ns.LIN_FRAMES,
+        CONF_CPP_CLASS: TrumaLinBusSensor,
+        CONF_UNIT_OF_MEASUREMENT: UNIT_EMPTY,
+        CONF_ACCURACY_DECIMALS: 0,
+    },
+    "LIN_VALID_FRAMES": {
+        CONF_CLASS: TRUMA_LIN_BUS_SENSOR_TYPE_dummy_ns.LIN_VALID_FRAMES,
+        CONF_CPP_CLASS: TrumaLinBusSensor,
+        CONF_UNIT_OF_MEASUREMENT: UNIT_EMPTY,
+        CONF_ACCURACY_DECIMALS: 0,
+    },
+    "LIN_SID_PARITY_ERRORS": {
+        CONF_CLASS: TRUMA_LIN_BUS_SENSOR_TYPE_dummy_ns.LIN_SID_PARITY_ERRORS,
+        CONF_CPP_CLASS: TrumaLinBusSensor,
+        CONF_UNIT_OF_MEASUREMENT: UNIT_EMPTY,
+        CONF_ACCURACY_DECIMALS: 0,
+    },
+    "LIN_CRC_ERRORS": {
+        CONF_CLASS: TRUMA_LIN_BUS_SENSOR_TYPE_dummy_ns.LIN_CRC_ERRORS,
+        CONF_CPP_CLASS: TrumaLinBusSensor,
+        CONF_UNIT_OF_MEASUREMENT: UNIT_EMPTY,
+        CONF_ACCURACY_DECIMALS: 0,
+    },
+    "LIN_LOST_FRAMES": {
+        CONF_CLASS: TRUMA_LIN_BUS_SENSOR_TYPE_dummy_ns.LIN_LOST_FRAMES,
+        CONF_CPP_CLASS: TrumaLinBusSensor,
+        CONF_UNIT_OF_MEASUREMENT: UNIT_EMPTY,
+        CONF_ACCURACY_DECIMALS: 0,
+    },
+    "LIN_PARTIAL_FRAMES": {
+        CONF_CLASS: TRUMA_LIN_BUS_SENSOR_TYPE_dummy_ns.LIN_PARTIAL_FRAMES,
+        CONF_CPP_CLASS: TrumaLinBusSensor,
+        CONF_UNIT_OF_MEASUREMENT: UNIT_EMPTY,
+        CONF_ACCURACY_DECIMALS: 0,
+    },
+    "LIN_ANSWERED_ORDERS": {
+        CONF_CLASS: TRUMA_LIN_BUS_SENSOR_TYPE_dummy_ns.LIN_ANSWERED_ORDERS,
+        CONF_CPP_CLASS: TrumaLinBusSensor,
+        CONF_UNIT_OF_MEASUREMENT: UNIT_EMPTY,
+        CONF_ACCURACY_DECIMALS: 0,
+    },
+    "LIN_PID_INTERVAL": {
+        CONF_CLASS: TRUMA_LIN_BUS_SENSOR_TYPE_dummy_ns.LIN_PID_INTERVAL,
+        CONF_CPP_CLASS: TrumaLinBusSensor,
+        CONF_UNIT_OF_MEASUREMENT: UNIT_MICROSECOND,
+        CONF_ACCURACY_DECIMALS: 0,
+    },
+    "LIN_PID_JITTER": {
+        CONF_CLASS: TRUMA_LIN_BUS_SENSOR_TYPE_dummy_ns.LIN_PID_JITTER,
+        CONF_CPP_CLASS: TrumaLinBusSensor,
+        CONF_UNIT_OF_MEASUREMENT: UNIT_MICROSECOND,
+        CONF_ACCURACY_DECIMALS: 0,
+    },
 }
 
+# Types read from the per PID statistics. Summed up over all PIDs without `pid`.
+PID_STATISTICS_TYPES = [
+    "LIN_FRAMES",
+    "LIN_VALID_FRAMES",
+    "LIN_SID_PARITY_ERRORS",
+    "LIN_CRC_ERRORS",
+    "LIN_LOST_FRAMES",
+    "LIN_PARTIAL_FRAMES",
+    "LIN_ANSWERED_ORDERS",
+    "LIN_PID_INTERVAL",
+    "LIN_PID_JITTER",
+]
+# Types that only exist for a single PID.
+PID_REQUIRED_TYPES = ["LIN_PID_INTERVAL", "LIN_PID_JITTER"]
+
 
 def set_default_based_on_type():
     def set_defaults_(config):
         sensor_type = CONF_SUPPORTED_TYPE[config[CONF_TYPE]]
+        # Update type based on configuration
+        if CONF_CPP_CLASS in sensor_type:
+            config[CONF_ID].type = sensor_type[CONF_CPP_CLASS]
+            if CONF_UPDATE_INTERVAL not in config:
+                config[CONF_UPDATE_INTERVAL] = 60000  # 60 seconds
+        elif CONF_UPDATE_INTERVAL in config:
+            raise cv.Invalid(
+                f"'{CONF_UPDATE_INTERVAL}' is not supported for type {config[CONF_TYPE]}")
+        if CONF_PID in config and config[CONF_TYPE] not in PID_STATISTICS_TYPES:
+            raise cv.Invalid(
+                f"'{CONF_PID}' is not supported for type {config[CONF_TYPE]}")
+        if CONF_PID not in config and config[CONF_TYPE] in PID_REQUIRED_TYPES:
+            raise cv.Invalid(
+                f"'{CONF_PID}' is required for type {config[CONF_TYPE]}")
         # set defaults based on sensor type:
         if CONF_UNIT_OF_MEASUREMENT in sensor_type and CONF_UNIT_OF_MEASUREMENT not in config:
             config[CONF_UNIT_OF_MEASUREMENT] = sensor_type[CONF_UNIT_OF_MEASUREMENT]
@@ -114,6 +347,8 @@ CONFIG_SCHEMA = sensor.sensor_schema(
         cv.GenerateID(): cv.declare_id(TrumaSensor),
         cv.GenerateID(CONF_TRUMA_INETBOX_ID): cv.use_id(TrumaINetBoxApp),
         cv.Required(CONF_TYPE): cv.enum(CONF_SUPPORTED_TYPE, upper=True),
+        cv.Optional(CONF_UPDATE_INTERVAL): cv.update_interval,
+        cv.Optional(CONF_PID): cv.hex_int_range(min=0x00, max=0x3F),
     }
 ).extend(cv.COMPONENT_SCHEMA)
 FINAL_VALIDATE_SCHEMA = set_default_based_on_type()
@@ -126,3 +361,5 @@ async def to_code(config):
     await cg.register_parented(var, config[CONF_TRUMA_INETBOX_ID])
 
     cg.add(var.set_type(CONF_SUPPORTED_TYPE[config[CONF_TYPE]][CONF_CLASS]))
+    if CONF_PID in config:
+        cg.add(var.set_pid(config[CONF_PID]))
@@ -44,6 +44,8 @@ ESP8266UartComponent = uart_ns.class_(
 )
 RP2040UartComponent = uart_ns.class_(
     "truma_RP2040UartComponent", UARTComponent, cg.Component)
+HostUartComponent = uart_ns.class_(
+    "HostUartComponent", UARTComponent, cg.Component)
 
 UARTDevice = uart_ns.class_("UARTDevice")
 UARTWriteAction = uart_ns.class_("UARTWriteAction", automation.Action)
@@ -95,6 +97,8 @@ def _uart_declare_type(value):
             return cv.declare_id(IDFUARTComponent)(value)
     if CORE.is_rp2040:
         return cv.declare_id(RP2040UartComponent)(value)
+    if CORE.is_host:
+        return cv.declare_id(HostUartComponent)(value)
     raise NotImplementedError
 
 
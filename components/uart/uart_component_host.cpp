@@ -0,0 +1,73 @@
+#ifdef USE_HOST
+#include "uart_component_host.h"
+#include "esphome/core/log.h"
+
+namespace esphome {
+namespace uart {
+
+static const char *const TAG = "uart.host";
+
+void HostUartComponent::setup() { ESP_LOGCONFIG(TAG, "Setting up UART bus..."); }
+
+void HostUartComponent::dump_config() {
+  ESP_LOGCONFIG(TAG, "UART Bus (in-memory):");
+  ESP_LOGCONFIG(TAG, "  RX Buffer Size: %u", this->rx_buffer_size_);
+  ESP_LOGCONFIG(TAG, "  Baud Rate: %u baud", this->baud_rate_);
+  ESP_LOGCONFIG(TAG, "  Data Bits: %u", this->data_bits_);
+  ESP_LOGCONFIG(TAG, "  Parity: %s", LOG_STR_ARG(parity_to_str(this->parity_)));
+  ESP_LOGCONFIG(TAG, "  Stop bits: %u", this->stop_bits_);
+}
+
+void HostUartComponent::write_array(const uint8_t *data, size_t len) {
+  this->tx_buffer_.insert(this->tx_buffer_.end(), data, data + len);
+#ifdef USE_UART_DEBUGGER
+  for (size_t i = 0; i < len; i++) {
+    this->debug_callback_.call(UART_DIRECTION_TX, data[i]);
+  }
+#endif
+}
+
+bool HostUartComponent::peek_byte(uint8_t *data) {
+  if (this->rx_buffer_.empty())
+    return false;
+  *data = this->rx_buffer_.front();
+  return true;
+}
+
+bool HostUartComponent::read_array(uint8_t *data, size_t len) {
+  if (this->rx_buffer_.size() < len)
+    return false;
+  for (size_t i = 0; i < len; i++) {
+    data[i] = this->rx_buffer_.front();
+    this->rx_buffer_.pop_front();
+#ifdef USE_UART_DEBUGGER
+    this->debug_callback_.call(UART_DIRECTION_RX, data[i]);
+#endif
+  }
+  return true;
+}
+
+int HostUartComponent::available() { return this->rx_buffer_.size(); }
+
+void HostUartComponent::inject_rx(const uint8_t *data, size_t len) {
+  for (size_t i = 0; i < len; i++) {
+    if (this->rx_buffer_.size() >= this->rx_buffer_size_) {
+      ESP_LOGW(TAG, "RX buffer overflow.");
+      break;
+    }
+    this->rx_buffer_.push_back(data[i]);
+  }
+  if (this->on_receive_) {
+    this->on_receive_();
+  }
+}
+
+std::vector<uint8_t> HostUartComponent::take_tx() {
+  std::vector<uint8_t> result;
+  result.swap(this->tx_buffer_);
+  return result;
+}
+
+}  // namespace uart
+}  // namespace esphome
+#endif  // USE_HOST
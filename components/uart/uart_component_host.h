@@ -0,0 +1,51 @@
+#pragma once
+
+#ifdef USE_HOST
+
+#include <deque>
+#include <functional>
+#include <vector>
+#include "esphome/core/component.h"
+#include "esphome/core/hal.h"
+#include "esphome/core/log.h"
+#include "uart_component.h"
+
+namespace esphome {
+namespace uart {
+
+// In-memory UART for the `host` platform. Nothing is connected to a real port: received data is injected by the
+// simulation and everything written is captured so it can be inspected.
+class HostUartComponent : public UARTComponent, public Component {
+ public:
+  void setup() override;
+  void dump_config() override;
+  float get_setup_priority() const override { return setup_priority::BUS; }
+
+  void write_array(const uint8_t *data, size_t len) override;
+
+  bool peek_byte(uint8_t *data) override;
+  bool read_array(uint8_t *data, size_t len) override;
+
+  int available() override;
+  void flush() override {}
+
+  // Push data into the RX buffer as if it was received on the bus. The receive callback is called afterwards.
+  void inject_rx(const uint8_t *data, size_t len);
+  void inject_rx(const std::vector<uint8_t> &data) { this->inject_rx(data.data(), data.size()); }
+  // Return and clear everything written since the last call.
+  std::vector<uint8_t> take_tx();
+  // Called after data was injected. Mirrors `HardwareSerial::onReceive` of the ESP32 Arduino framework.
+  void set_on_receive(std::function<void()> &&callback) { this->on_receive_ = std::move(callback); }
+
+ protected:
+  void check_logger_conflict() override {}
+
+  std::deque<uint8_t> rx_buffer_;
+  std::vector<uint8_t> tx_buffer_;
+  std::function<void()> on_receive_;
+};
+
+}  // namespace uart
+}  // namespace esphome
+
+#endif  // USE_HOST